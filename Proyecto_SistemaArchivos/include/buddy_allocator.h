@@ -0,0 +1,39 @@
+//buddy_allocator.h
+#ifndef BUDDY_ALLOCATOR_H
+#define BUDDY_ALLOCATOR_H
+
+#include <vector>
+
+class SnapshotWriter;
+class SnapshotReader;
+
+// Sistema buddy sobre marcos físicos: bloques contiguos de 2^orden marcos,
+// asignación y liberación en O(log n) con fusión de buddies libres.
+class BuddyAllocator {
+private:
+    int totalFrames;
+    int maxOrder;
+    int freeFrames;
+    std::vector<int> freeHead;     // Cabeza de la lista libre de cada orden
+    std::vector<int> prev;         // Enlaces de las listas libres (por marco inicial)
+    std::vector<int> next;
+    std::vector<int> freeOrder;    // Orden del bloque libre que empieza en el marco, -1 si no hay
+
+    void pushFree(int start, int order);
+    void removeFree(int start);
+
+public:
+    BuddyAllocator(int frames = 0);
+    void init(int frames);
+    int allocate(int order);               // Marco inicial del bloque, -1 si no hay
+    void free(int start, int order);
+    static int orderFor(int frames);       // Menor orden con 2^orden >= frames
+    int getFreeFrames() const;
+    int getMaxOrder() const;
+    int largestFreeBlock() const;          // En marcos
+    int freeBlocksOfOrder(int order) const;
+    void saveState(SnapshotWriter& out) const;
+    bool loadState(SnapshotReader& in, int frames);   // Falla si no tiene `frames` marcos
+};
+
+#endif
@@ -9,9 +9,15 @@
 #include <condition_variable>
 #include <chrono>
 #include <random>
+#include <memory>
+#include <functional>
+
+class SnapshotWriter;
+class SnapshotReader;
 
 enum class DeviceType { PRINTER, DISK_DRIVE, NETWORK, KEYBOARD };
-enum class InterruptType { TIMER, IO_COMPLETE, PAGE_FAULT, SYSTEM_CALL };
+// SWAP_OUT: fin de una escritura al swap; no es la E/S de ningún proceso
+enum class InterruptType { TIMER, IO_COMPLETE, PAGE_FAULT, SYSTEM_CALL, SWAP_OUT };
 
 struct IORequest {
     int processId;
@@ -19,6 +25,10 @@ struct IORequest {
     std::string data;
     int priority;
     int duration;
+    std::function<void()> transfer = nullptr;     // E/S real que ejecuta el dispositivo (opcional)
+    std::function<void()> onComplete = nullptr;   // Se llama después de generar la interrupción
+    InterruptType completion = InterruptType::IO_COMPLETE;
+    int completionData = -1;              // -1 = índice del dispositivo
 };
 
 struct Interrupt {
@@ -37,6 +47,9 @@ private:
     
     std::queue<Interrupt> interruptQueue;
     mutable std::mutex interruptMutex;  // CORREGIDO: agregar 'mutable'
+    // Manejadores por tipo de interrupción; se llaman sin interruptMutex tomado
+    std::vector<std::function<bool(const Interrupt&)>> interruptHandlers;
+    std::mutex handlerMutex;
     
     bool running;
     bool verboseMode;
@@ -49,11 +62,20 @@ public:
     ~DeviceManager();
     
     bool requestIO(int processId, DeviceType device, const std::string& data, int priority, int duration);
+    bool submitIO(const IORequest& request);   // Encola sin mensajes (uso interno de otros gestores)
     void listDeviceQueues() const;
     void generateInterrupt(InterruptType type, int processId, int data = 0);
     void processNextInterrupt();
     void showInterruptStatus() const;
     void setVerboseMode(bool verbose);
+    // Entrega inmediata: las interrupciones de los dispositivos de ese tipo pasan
+    // primero por el manejador y solo se encolan si devuelve false. nullptr lo quita
+    void setInterruptHandler(InterruptType type, std::function<bool(const Interrupt&)> handler);
+    // Instantánea: solicitudes encoladas desde el menú y la cola de interrupciones. Las
+    // transferencias internas (swap, E/S de procesos) no se guardan; al restaurar, las
+    // que tienen quien espera su onComplete siguen en la cola
+    void saveState(SnapshotWriter& out) const;
+    bool loadState(SnapshotReader& in, std::function<void()>& commit);
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,10 @@
 #include <queue>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+
+class SnapshotWriter;
+class SnapshotReader;
 
 enum class DiskAlgorithm { FCFS, SSTF, SCAN };
 
@@ -30,6 +34,13 @@ public:
     void setHeadPosition(int position);
     void clearRequests();
     void compareAlgorithms();
+    int getHeadPosition() const;
+    // Atiende un lote sin salida por consola, partiendo de `head` y dejándolo donde
+    // termina; devuelve el movimiento total. O(n log n) también para SSTF
+    long long serveRequests(const std::vector<DiskRequest>& batch, DiskAlgorithm algorithm, int& head) const;
+    // Instantánea: solicitudes pendientes, cabezal, algoritmo y último recorrido
+    void saveState(SnapshotWriter& out) const;
+    bool loadState(SnapshotReader& in, std::function<void()>& commit);
 };
 
 #endif
\ No newline at end of file
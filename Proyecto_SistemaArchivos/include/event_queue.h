@@ -0,0 +1,45 @@
+//event_queue.h
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+
+// Eventos del simulador de procesos. Con el mismo instante se atienden en este
+// orden: un proceso que llega, o que termina su E/S o la lectura de una página, entra
+// en la cola antes que el expulsado por quantum. IO_BLOCK y PAGE_BLOCK cierran el
+// turno de quien pide E/S o sufre un fallo de página
+enum class EventType { ARRIVAL, IO_COMPLETE, PAGE_FAULT, COMPLETION, IO_BLOCK, PAGE_BLOCK, QUANTUM_EXPIRY,
+                       PRIORITY_BOOST };
+
+struct SimEvent {
+    long long time;    // Instante virtual, en unidades de CPU
+    EventType type;
+    int process;       // Índice del proceso dentro de la simulación
+    long long seq;     // Orden de inserción: desempata de forma reproducible
+};
+
+// Reloj virtual y cola de eventos en un montículo binario ordenado por instante.
+// El reloj salta de un evento al siguiente, sin esperar tiempo real.
+class EventQueue {
+private:
+    std::vector<SimEvent> heap;
+    long long now;
+    long long nextSeq;
+    long long processed;
+
+    static bool later(const SimEvent& a, const SimEvent& b);
+
+public:
+    EventQueue();
+    long long schedule(long long time, EventType type, int process);   // Devuelve su seq
+    SimEvent pop();                    // Avanza el reloj al instante del evento
+    const SimEvent& peek() const;
+    bool empty() const;
+    size_t size() const;
+    long long getTime() const;
+    long long getProcessed() const;
+    void clear();                      // Vacía la cola y pone el reloj a 0
+};
+
+#endif
@@ -5,6 +5,10 @@
 
 #include <string>
 #include <vector>
+#include <functional>
+
+class SnapshotWriter;
+class SnapshotReader;
 
 struct File {
     std::string name;
@@ -23,6 +27,10 @@ public:
     void writeFile(const std::string &name, const std::string &data);
 
     File* selectFileForWrite();
+
+    // Instantánea: nombre y contenido de cada archivo
+    void saveState(SnapshotWriter& out) const;
+    bool loadState(SnapshotReader& in, std::function<void()>& commit);
 };
 
 #endif
\ No newline at end of file
@@ -7,49 +7,435 @@
 #include <queue>
 #include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include "buddy_allocator.h"
+#include "swap_space.h"
+#include "device_manager.h"
 
-enum class PageReplacement { FIFO, LRU, WORKING_SET };
+class SnapshotWriter;
+class SnapshotReader;
 
+enum class PageReplacement { FIFO, LRU, WORKING_SET, OPT };
+// Dónde se buscan marcos para un proceso: su nodo y luego los demás, repartido
+// entre todos los nodos por página virtual, o solo su nodo
+enum class NumaPolicy { LOCAL_FIRST, INTERLEAVE, BIND };
+
+// Los hits actualizan modified/lastUsed sin tomar locks (como los bits A/D
+// que pone la MMU), por eso son atómicos
 struct Page {
     int pageId;
     int processId;
     bool referenced;
-    bool modified;
-    int lastUsed;
-    std::vector<int> accessHistory;  // Para Working Set
+    std::atomic<bool> modified;
+    std::atomic<bool> huge;   // Subpágina de una página enorme: una sola entrada de TLB
+    std::atomic<bool> prefetched;   // Cargada por readahead y aún sin usar
+    std::atomic<int> mapCount;      // Claves (proceso, página) que mapean el marco; >1 = compartido tras un fork
+    std::atomic<long long> lastUsed;
+
+    Page(int page = -1, int process = -1);
+    Page(const Page& other);
+    Page& operator=(const Page& other);
+};
+
+// Referencia de una traza: (proceso, página virtual)
+struct PageRef {
+    int processId;
+    int virtualPage;
+    bool write = false;   // Las escrituras marcan la página como modificada
+};
+
+// Resultado de un lote de accesos
+struct AccessResult {
+    long long hits;
+    long long faults;
+};
+
+// Traza de referencias cargada desde archivo (formato de scripts/mem_*.txt)
+struct ReferenceTrace {
+    std::vector<PageRef> refs;
+    int frames = 0;            // "Marcos disponibles", 0 si no se indica
+    int window = 0;            // "Ventana de trabajo", 0 si no se indica
+    bool hasPolicy = false;
+    PageReplacement policy = PageReplacement::FIFO;
+};
+
+// Bloque buddy asignado a un proceso
+struct FrameBlock {
+    int start;
+    int order;
+    int requested;   // Marcos pedidos; el resto del bloque es fragmentación interna
+};
+
+// Marcos físicos que pertenecen a un proceso
+struct ProcessFrames {
+    std::vector<FrameBlock> blocks;
+    std::vector<int> spare;   // Marcos propios sin página cargada
+};
+
+// Lista doblemente enlazada intrusiva sobre índices de marco (orden FIFO / LRU)
+struct FrameList {
+    std::vector<int> prev;
+    std::vector<int> next;
+    int head = -1;
+    int tail = -1;
+
+    void init(int frames);
+    void pushBack(int frame);
+    void remove(int frame);
+    void moveToBack(int frame);
+};
+
+// Índice hash (proceso, página) -> marco con sondeo lineal, O(1) por acceso.
+// Las ranuras son atómicas para que find() pueda correr junto a un escritor;
+// MemoryManager valida esas lecturas con un contador de secuencia (seqlock).
+class PageIndex {
+private:
+    struct Slot {
+        std::atomic<uint64_t> key;
+        std::atomic<int> frame;     // -1 = vacío
+    };
+    std::unique_ptr<Slot[]> slots;
+    uint64_t mask;
+    int shift;
+    size_t used = 0;
+
+    size_t home(uint64_t key) const;
+
+public:
+    void init(int capacity);
+    int find(uint64_t key) const;
+    void insert(uint64_t key, int frame);
+    void erase(uint64_t key);
+    size_t size() const;
+    void reserve(size_t capacity);   // Rehace la tabla si no caben (sin lectores concurrentes)
 };
 
+// Árbol de Fenwick sobre marcas de tiempo: cuenta cuántas páginas distintas
+// se referenciaron después de un instante (estadístico de orden en O(log n))
+class FenwickTree {
+private:
+    std::vector<int> tree;
+
+public:
+    void init(size_t size);
+    void add(size_t position, int delta);
+    long long prefixSum(size_t position) const;   // suma de [0, position)
+};
+
+// Caché de marcos libres de un CPU: los fallos toman marcos sin pasar por el buddy
+struct FrameCache {
+    std::mutex lock;
+    std::vector<int> frames;
+};
+
+// Nodo de memoria (NUMA): rango contiguo de marcos con su propio buddy. Un acceso
+// desde un proceso de otro nodo paga la latencia remota
+struct MemoryNode {
+    int firstFrame = 0;
+    int frames = 0;
+    BuddyAllocator buddy;
+    int localLatencyNs = 80;
+    int remoteLatencyNs = 140;
+    std::atomic<int> cachedFrames{0};      // Marcos del nodo en las cachés por CPU
+    std::atomic<bool> exhausted{false};    // El último relleno no obtuvo marcos de su buddy
+    std::atomic<long long> localAccesses{0};
+    std::atomic<long long> remoteAccesses{0};
+};
+
+// Flujo de accesos de un proceso para el readahead: tras dos fallos con el mismo
+// salto se precargan las siguientes `window` páginas
+struct ReadaheadStream {
+    int lastPage = -1;
+    int stride = 0;
+    int window = 0;
+    int nextPage = 0;      // Primera página aún sin precargar
+    bool active = false;   // Patrón confirmado
+};
+
+// TLB de un CPU (solo para estadísticas): correspondencia directa, una entrada
+// por página base o por página enorme. La traducción siempre usa el índice.
+struct CpuTlb {
+    static constexpr int ENTRIES = 64;
+    std::atomic<uint64_t> tags[ENTRIES];
+};
+
+// Sincronización (de fuera hacia dentro):
+//   tableLock    compartido en los accesos; exclusivo en asignar/liberar, OPT, páginas enormes y la salida por consola
+//   stripeLocks  franja de la clave (proceso, página): serializa los fallos de una misma página
+//   replacementLock  listas de reemplazo (FIFO, montículo LRU, OPT) y escrituras del índice
+//   allocLock / FrameCache::lock / swapMutex  hojas, se toman y sueltan enseguida
+// Los hits de lectura no toman ningún lock: índice con seqlock y marca de uso atómica.
 class MemoryManager {
 private:
+    using StampHeap = std::priority_queue<std::pair<long long, int>,
+                                          std::vector<std::pair<long long, int>>,
+                                          std::greater<std::pair<long long, int>>>;
+
+    // Detalle de un fallo para la salida de accessPage
+    struct FaultInfo {
+        int evictedProcess = -1;
+        int evictedPage = -1;
+        bool evictedDirty = false;
+        long long pageInMicros = -1;   // -1 si no se leyó del swap
+        int copiedFrom = -1;           // Marco compartido copiado al escribir (-1 si no hubo copia)
+    };
+
+    static constexpr int LOCK_STRIPES = 64;
+    static constexpr int FRAME_CACHE_BATCH = 8;
+
     int totalPages;
-    int usedPages;
+    std::atomic<int> usedPages;       // Marcos asignados a procesos
+    std::atomic<int> residentPages;   // Marcos con una página cargada
     std::vector<Page> pageTable;
-    std::queue<int> fifoQueue;
-    std::map<int, int> pageUsage;
+    std::vector<int> frameOwner;      // Proceso dueño de cada marco, -1 libre
+    std::vector<char> demandFrame;    // Marco suelto tomado en un fallo (no pertenece a un bloque)
+    std::map<int, ProcessFrames> processFrames;
+    std::atomic<int> spareFrames;     // Total de marcos de holgura (evita allocLock si es 0)
+    PageIndex pageIndex;              // (proceso, página) -> marco
+    std::atomic<unsigned> indexSequence;   // Impar mientras un escritor modifica el índice
+    FrameList fifoList;               // Orden de carga (contiene todos los marcos residentes)
+    // Orden LRU (no se mantiene con FIFO)
+    FrameList lruList;                // Por orden de carga, marcos sin hits desde que se cargaron
+    StampHeap lruRefreshed;           // (última marca, marco) de los que tuvieron hits; entradas viejas se descartan al sacar
+    std::vector<long long> lruStamp;  // Marca con la que el marco está en lruList o lruRefreshed, -1 si en ninguno
     PageReplacement replacementPolicy;
-    int accessCounter;
-    int pageFaults;           // AÑADIDO
-    int pageHits;             // AÑADIDO
+    std::atomic<long long> accessCounter;
+    std::atomic<long long> pageFaults;     // AÑADIDO
+    std::atomic<long long> pageHits;       // AÑADIDO
     int workingSetWindow;     // AÑADIDO
-    
+
+    mutable std::shared_mutex tableLock;
+    std::atomic<int> exclusiveWaiters;  // Los lotes ceden el paso: el lock compartido prefiere lectores
+    std::mutex stripeLocks[LOCK_STRIPES];
+    std::mutex replacementLock;
+    std::mutex allocLock;
+    int cpuCount;
+    std::unique_ptr<FrameCache[]> frameCaches;   // Una por CPU y nodo: [cpu * nodeCount + nodo]
+
+    // NUMA: cada nodo tiene sus marcos libres; un proceso sin nodo asignado usa pid % nodos
+    static constexpr int MAX_NODES = 8;
+    int nodeCount;
+    std::vector<std::unique_ptr<MemoryNode>> nodes;
+    std::vector<int> frameNode;                // Nodo de cada marco
+    NumaPolicy numaPolicy;
+    std::unordered_map<int, int> homeNodes;    // Solo se modifica con la tabla en exclusiva
+
+    // Copy-on-write: claves de cada marco compartido tras un fork (con replacementLock).
+    // pageTable guarda una de ellas; la primera escritura de cualquiera copia la página
+    std::unordered_map<int, std::vector<uint64_t>> frameSharers;
+    std::atomic<long long> sharedMappings;    // Mapeos extra sobre marcos compartidos = marcos ahorrados
+    std::atomic<long long> forkedPages;
+    std::atomic<long long> cowFaults;
+
+    // Páginas enormes: bloque buddy alineado de 2^hugePageOrder marcos que mapea una
+    // región virtual alineada del proceso (0 = desactivadas)
+    static constexpr uint64_t HUGE_TAG = 1ULL << 31;
+    static constexpr uint64_t TLB_EMPTY = ~0ULL;
+    static constexpr size_t HUGE_SCAN_REFS = 4096;   // Referencias entre pasadas al reproducir trazas
+    int hugePageOrder;
+    int hugePageThreshold;                    // % de la región residente para promoverla
+    std::vector<long long> hugeStamp;         // Marca de la promoción (en el primer marco del bloque)
+    std::atomic<int> hugePages;
+    std::atomic<long long> hugePromotions;
+    std::atomic<long long> hugeSplits;
+    bool tlbEnabled;                          // El modelo de TLB cuesta en cada acceso: solo si se pide
+    std::atomic<long long> tlbMisses;
+    std::unique_ptr<CpuTlb[]> tlbs;
+    // Pasada periódica en segundo plano (como khugepaged)
+    std::thread hugePageDaemon;
+    std::mutex daemonMutex;
+    std::condition_variable daemonWake;
+    bool daemonStop;
+
+    // Readahead: flujo secuencial o con salto fijo por proceso; la ventana se
+    // duplica en cada ronda útil y se reduce a la mitad por cada precarga desperdiciada
+    static constexpr int READAHEAD_INITIAL = 4;
+    static constexpr int READAHEAD_MAX = 64;
+    static constexpr int READAHEAD_MAX_STRIDE = 64;
+    bool readaheadEnabled;
+    std::map<int, ReadaheadStream> streams;   // Protegido por readaheadLock (hoja)
+    std::mutex readaheadLock;
+    std::atomic<long long> prefetchesIssued;
+    std::atomic<long long> prefetchesUseful;
+    std::atomic<long long> prefetchesWasted;
+
+    // OPT (Belady): próximo uso de cada marco dentro del lote en curso
+    static constexpr long long NEVER_USED = 0x7fffffffffffffffLL;
+    bool optActive;
+    std::vector<long long> optNextUse;
+    std::priority_queue<std::pair<long long, int>> optHeap;
+
+    // Curva de tasa de fallos LRU (índice = número de marcos)
+    std::vector<double> missRatioCurve;
+    size_t missRatioReferences;
+
+    // Swap en archivo (opcional): las transferencias van por el disco del DeviceManager
+    std::unique_ptr<SwapSpace> swap;
+    DeviceManager* swapDevice;
+    int swapLatencyMs;
+    std::atomic<long long> pageIns;
+    std::atomic<long long> pageInNanos;
+    std::atomic<long long> writeBacks;
+    std::atomic<long long> writeBackNanos;
+    std::atomic<long long> swapErrors;
+    int pendingSwapIO;                 // Protegido por swapMutex
+    mutable std::mutex swapMutex;      // También protege las ranuras de swap
+    std::condition_variable swapDrained;
+
+    static uint64_t makeKey(int processId, int virtualPage);
+    std::unique_lock<std::shared_mutex> lockTableExclusive();
+    void yieldToExclusive() const;
+    std::mutex& stripeFor(uint64_t key);
+    int cpuSlot(int cpu) const;
+    int lookupFrame(uint64_t key) const;
+    void indexInsert(uint64_t key, int frame);
+    void indexErase(uint64_t key);
     int findVictimPage();
     int findWorkingSetVictim();      // AÑADIDO
-    void updatePageUsage(int pageIndex);
-    void updateWorkingSet(int pageIndex);  // AÑADIDO
+    bool outsideWorkingSet(int frame, long long stamp) const;
+    void trimWorkingSet(long long stamp, std::mutex* ownStripe);
+    int popLruVictim();
+    void requeueVictim(int frame);
+    void refreshLru(int frame, long long stamp);
+    void rebuildLruOrder();
+    int findVictimOnNode(int node, std::vector<int>& skipped);
+    bool tryEvictVictim(int frame, std::mutex* ownStripe, FaultInfo* info);
+    int claimVictim(std::mutex* ownStripe, FaultInfo* info, int node = -1);
+    int claimVictimOnNode(std::mutex* ownStripe, FaultInfo* info, int node);
+    int readHit(const PageRef& ref, long long stamp);
+    int touchPage(const PageRef& ref, long long stamp, int cpu, bool& hit, FaultInfo* info);
+    void installPage(int frame, int processId, int virtualPage, long long stamp, bool write, bool prefetch = false);
+    void mapPage(int frame, int processId, int virtualPage, long long stamp, bool write, bool prefetch = false);
+    void evictFrame(int frame);
+    void dropPage(int frame);
+    void releaseFrame(int frame);
+    void unmapKey(int frame, uint64_t key);
+    int unmapSharedPages(int processId, int limit);
+    int obtainFrame(int processId, int virtualPage, long long stamp, int cpu, std::mutex* ownStripe, FaultInfo* info);
+    int copyOnWrite(int processId, int virtualPage, int shared, long long stamp, int cpu,
+                    std::mutex* ownStripe, FaultInfo* info);
+    int takeFrame(int processId, int virtualPage, int cpu);
+    int takeNodeFrame(int node, int cpu);
+    int refillFrameCache(int node, int cpu);
+    void drainFrameCaches();
+    void releaseBlock(const FrameBlock& block, int processId);
+    void buildNodes(int count);
+    int homeNodeOf(int processId) const;
+    int nodeCandidates(int processId, int virtualPage, int* candidates) const;
+    int allocateBlock(int order, int processId, int virtualPage);
+    void allocateOnNode(int node, int pages, std::vector<FrameBlock>& blocks);
+    void freeBlock(int start, int order);
+    int freeFrameCount() const;
+    void refreshExhausted();
+    void countNodeAccess(int processId, int frame, long long* counts, int& lastProcess, int& lastHome) const;
+    void addNodeAccesses(const long long* counts);
+    bool allocateFrames(int pages, int processId, bool contiguousOnly);
+    int loadPage(int processId, int virtualPage, bool write, long long stamp, int cpu,
+                 std::mutex* ownStripe, FaultInfo* info, bool prefetch = false);
+    int findOptimalVictim();
+    AccessResult accessPagesOptimal(const PageRef* refs, size_t count, uint64_t* bits);
+    void scheduleWriteBack(int processId, int virtualPage);
+    long long pageInFromSwap(int processId, int virtualPage, int slot);
+    void finishSwapIO();
+    void waitForSwapIO();
+    void printStatistics() const;
+    uint64_t hugeTag(uint64_t key) const;
+    bool tlbAccess(CpuTlb& tlb, uint64_t key, int frame);
+    void tlbShootdown(uint64_t tag);
+    int collapseHugePages();
+    void collapseRegion(uint64_t region, int start);
+    int hugeStartOf(int frame) const;
+    void splitHugePage(int start);
+    void splitProcessHugePages(int processId);
+    int countBloatPages() const;
+    void stopHugePageDaemon();
+    int readaheadOnFault(int processId, int virtualPage, long long stamp, int cpu);
+    int readaheadOnHit(int processId, int virtualPage, long long stamp, int cpu);
+    int prefetchPages(int processId, int firstPage, int stride, int count, long long stamp, int cpu);
+    void prefetchWasted(int processId, int virtualPage);
 
 public:
-    MemoryManager(int total = 16);
+    MemoryManager(int total = 16, int nodeCount = 1);
+    ~MemoryManager();
     bool allocate(int pages, int processId);
+    bool allocateContiguous(int pages, int processId);   // Falla si no hay un bloque contiguo
     void free(int pages, int processId);
     void freeProcessPages(int processId);
+    // El hijo mapea las páginas residentes del padre sin copiarlas; la primera
+    // escritura de cualquiera de los dos copia la página (copy-on-write)
+    bool fork(int parentPid, int childPid);
+    long long getCowFaults() const;
+    long long getSharedPages() const;     // Marcos que ahorra ahora la compartición
     int getUsedPages() const;
     int getTotalPages() const;
     void showMemoryStatus() const;
-    void setReplacementPolicy(PageReplacement policy);
-    void accessPage(int processId, int virtualPage);
+    void setReplacementPolicy(PageReplacement policy, bool verbose = true);
+    PageReplacement getReplacementPolicy() const;
+    // accessPage, accessPages, allocate y free pueden llamarse desde varios hilos (CPUs simulados)
+    void accessPage(int processId, int virtualPage, bool write = false);
+    // Lote silencioso: sin salida por consola. Si outcomeBitmap != nullptr,
+    // el bit i queda en 1 cuando el acceso i fue HIT. cpu elige la caché de
+    // marcos libres (-1 = según el hilo que llama).
+    AccessResult accessPages(const PageRef* refs, size_t count, std::vector<uint64_t>* outcomeBitmap = nullptr,
+                             int cpu = -1);
+    AccessResult accessPages(const std::vector<PageRef>& refs, std::vector<uint64_t>* outcomeBitmap = nullptr,
+                             int cpu = -1);
+    AccessResult replayTrace(const ReferenceTrace& trace);
+    static bool loadReferenceTrace(const std::string& path, ReferenceTrace& trace);
     void showPageTable() const;
     void showStatistics() const;        // AÑADIDO
-    void setWorkingSetWindow(int window);  // AÑADIDO
+    // Análisis de distancia de pila (Mattson): curva LRU para todo número de marcos en una pasada
+    void computeMissRatioCurve(const std::vector<PageRef>& refs);
+    const std::vector<double>& getMissRatioCurve() const;
+    bool exportMissRatioCurve(const std::string& path) const;
+    void setWorkingSetWindow(int window, bool verbose = true);  // AÑADIDO
+    // Swap: páginas sucias expulsadas se escriben al archivo y se releen en el siguiente fallo
+    bool enableSwap(DeviceManager* device, const std::string& path, int latencyMs = 0);
+    void disableSwap();
+    bool isSwapEnabled() const;
+    std::string getSwapPath() const;
+    // Páginas enormes con promoción transparente: una pasada tipo khugepaged junta
+    // las regiones alineadas con al menos thresholdPercent% de páginas residentes
+    // (cada scanIntervalMs en segundo plano si es > 0) y se dividen bajo presión
+    bool enableHugePages(int order = 9, int thresholdPercent = 75, int scanIntervalMs = 0);
+    void disableHugePages();
+    int promoteHugePages();              // Una pasada; devuelve las regiones promovidas
+    int getHugePageOrder() const;
+    int getHugePageThreshold() const;
+    void enableTlbModel();               // Cuenta fallos de TLB (se activa también con las páginas enormes)
+    long long getTlbMisses() const;
+    // Readahead: detecta recorridos secuenciales o con salto fijo por proceso y precarga
+    // las páginas siguientes (no se aplica a OPT, que ya conoce las referencias futuras)
+    void setReadahead(bool enabled);
+    bool isReadaheadEnabled() const;
+    // NUMA: reparte los marcos en `count` nodos (solo sin memoria asignada). Los
+    // accesos se cuentan como locales o remotos según el nodo de origen del proceso
+    bool configureNuma(int count, int localLatencyNs = 80, int remoteLatencyNs = 140);
+    bool setNodeLatency(int node, int localLatencyNs, int remoteLatencyNs);
+    int getNodeCount() const;
+    int getNodeLatency(int node, bool remote) const;
+    void setNumaPolicy(NumaPolicy policy);
+    NumaPolicy getNumaPolicy() const;
+    void setHomeNode(int processId, int node);   // -1 quita la asignación
+    int getHomeNode(int processId) const;
+    int leastLoadedNode() const;                 // Nodo con más marcos libres
+    // Instantánea: nodos con su buddy, tabla de páginas, bloques de cada proceso,
+    // compartición y contadores. Lo que estaba en el swap no se guarda: al restaurar
+    // se desactivan el swap y la pasada periódica de páginas enormes
+    void saveState(SnapshotWriter& out);
+    bool loadState(SnapshotReader& in, std::function<void()>& commit);
+    // Rendimiento de hits con 1, 2, 4, ... hilos, cada uno un proceso con fallos propios
+    static void runScalingBenchmark(int maxThreads, long long accessesPerThread = 4000000);
 };
 
-#endif
\ No newline at end of file
+#endif
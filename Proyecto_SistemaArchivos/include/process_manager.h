@@ -11,10 +11,20 @@
 #include <chrono>
 #include <mutex>
 #include <condition_variable>
+#include <unordered_map>
+#include <set>
+#include <functional>
 #include "memory_manager.h"
+#include "event_queue.h"
+#include "ready_list.h"
 
-enum class ProcessState { Nuevo, Listo, Ejecutando, Suspendido, Terminado };
-enum class SchedulerType { RR, SJF };
+class SnapshotWriter;
+class SnapshotReader;
+
+enum class ProcessState { Nuevo, Listo, Ejecutando, Suspendido, Bloqueado, Terminado };
+enum class SchedulerType { RR, SJF, MLFQ, SRTF, CFS };
+// Clase de tiempo real: por encima de la política normal, que solo usa la CPU sobrante
+enum class RealTimePolicy { EDF, RMS };
 
 struct Process {
     int pid;
@@ -25,40 +35,339 @@ struct Process {
     ProcessState state;
     int remainingTime;
     int waitTime;
+    int homeNode;  // Nodo NUMA donde se ejecuta y del que toma memoria
+    int level;     // Cola MLFQ actual: empieza en la prioridad y baja al agotar el quantum
+    int affinity;  // CPU fijo en la simulación SMP (-1 = cualquiera)
+    long long vruntime;   // CFS: tiempo de CPU ponderado por el peso, en 1/1024 de unidad
+    int period;    // Tiempo real: una activación cada "period" unidades (0 = esporádico, una sola)
+    int deadline;  // Tiempo real: plazo desde cada activación (0 = no es de tiempo real)
+    int ioInterval = 0;   // E/S: unidades de CPU entre solicitudes (0 = solo usa CPU)
+    int ioDuration = 0;   // Unidades que tarda el dispositivo en atender cada solicitud
+    int cpuSinceIo = 0;   // CPU usada desde la última E/S
+    int pageSpan = 0;     // Paginación: páginas virtuales que recorre (0 = no referencia memoria)
+    int workingSet = 0;   // Páginas [0, workingSet) donde cae la mayoría de sus referencias
+    int pagedUnits = 0;   // Unidades de CPU cuyas referencias ya se reprodujeron
+};
+
+// Entrada del montículo de SJF/SRTF: menor tiempo restante y, a igualdad, la que
+// entró antes en la cola
+struct ReadyEntry {
+    int remaining;
+    long long order;
+    int id;   // pid en el planificador interactivo, índice del lote en la simulación
+
+    bool operator>(const ReadyEntry& other) const {
+        if (remaining != other.remaining) return remaining > other.remaining;
+        return order > other.order;
+    }
+};
+
+// Nodo del árbol rojo-negro de CFS (std::set): menor vruntime y, a igualdad, el
+// que entró antes en el árbol
+struct CfsEntry {
+    long long vruntime;
+    long long order;
+    int id;   // pid en el planificador interactivo, índice del lote en la simulación
+
+    bool operator<(const CfsEntry& other) const {
+        if (vruntime != other.vruntime) return vruntime < other.vruntime;
+        return order < other.order;
+    }
+};
+
+// RR adaptativo: guarda en una ventana los tiempos restantes de los últimos procesos
+// que entraron en la cola de listos y cada RETUNE_EVERY turnos lleva el quantum al
+// percentil objetivo de esa ventana (con 80, 8 de cada 10 terminan en su turno sin
+// otro cambio de contexto y los largos siguen expulsándose)
+class QuantumTuner {
+public:
+    static constexpr int WINDOW = 64;
+    static constexpr int RETUNE_EVERY = 8;
+    static constexpr int MAX_QUANTUM = 64;
+
+    void reset(int initialQuantum, int targetPercentile);
+    void observe(int remaining);
+    int next();   // Quantum del siguiente turno
+    long long getRetunes() const;
+
+private:
+    int samples[WINDOW];
+    int count = 0;
+    int oldest = 0;
+    int percentile = 80;
+    int quantum = 2;
+    int turns = 0;
+    long long retunes = 0;
+};
+
+// Resultado de una simulación por eventos
+struct SimulationSummary {
+    int processes;
+    long long finishTime;     // Instante virtual en que termina el último proceso
+    long long events;
+    long long dispatches;
+    long long preemptions;    // Expulsiones por la llegada de un proceso más prioritario
+    double wallSeconds;
+    double avgWaiting;        // Tiempo medio en la cola de listos (sin las tareas de tiempo real)
+    double avgResponse;       // Media desde la llegada hasta el primer despacho
+    double avgTurnaround;     // Media desde la llegada hasta la terminación
+    double throughput;        // Procesos terminados por unidad de tiempo virtual
+    double utilization;       // Fracción del tiempo con la CPU ocupada
+    double fairnessLag;       // CFS: máxima diferencia de vruntime entre listos, en unidades
+    long long rtJobs;         // Activaciones de tareas de tiempo real terminadas
+    long long deadlineMisses; // Activaciones que terminaron después de su plazo
+    long long maxLateness;    // Mayor retraso sobre el plazo
+    double rtAvgResponse = 0.0;      // Por activación: desde su liberación hasta el primer despacho
+    double rtAvgTurnaround = 0.0;    // Por activación: desde su liberación hasta que termina
+    long long rtMaxTurnaround = 0;
+    int rtTasks = 0;                 // Tareas de tiempo real del lote
+    long long ioRequests = 0;        // Solicitudes de E/S atendidas por el dispositivo
+    double deviceUtilization = 0.0;  // Fracción del tiempo con el dispositivo ocupado
+    double ioBoundTurnaround = 0.0;  // Retorno medio de los procesos con E/S
+    double cpuBoundTurnaround = 0.0; // Retorno medio de los que solo usan CPU
+    double ioBoundThroughput = 0.0;  // Procesos con E/S terminados por unidad de tiempo
+    double cpuBoundThroughput = 0.0;
+    long long pageReferences = 0;    // Referencias reproducidas durante la ejecución
+    long long pageFaults = 0;        // Fallos de página (cada uno bloquea al proceso)
+    long long contextSwitches = 0;   // Despachos de un proceso distinto del último en CPU
+    long long switchOverhead = 0;    // Unidades de CPU perdidas en cambios de contexto
+    double avgQuantum = 0.0;         // RR y MLFQ: quantum medio concedido por turno
+    long long quantumRetunes = 0;    // RR adaptativo: veces que se reajustó el quantum
+};
+
+// Un tramo del diagrama de Gantt: el proceso ocupó la CPU en [start, end)
+struct GanttSlice {
+    int pid;
+    long long start;
+    long long end;
+};
+
+// Tiempos de un proceso al terminar la simulación
+struct ProcessMetrics {
+    int pid;
+    int arrival;
+    int burst;
+    long long response;
+    long long waiting;
+    long long turnaround;
+};
+
+// Métricas del hilo planificador
+struct SchedulerStats {
+    long long dispatches;      // Despachos hechos con mtx tomado
+    long long wakeups;         // Veces que un proceso listo despertó al planificador
+    double totalLatencyUs;     // Desde executeProcess/resumeProcess hasta el despacho
+    double maxLatencyUs;
+    double totalHoldUs;        // Tiempo con mtx tomado durante los despachos
+    double maxHoldUs;
+};
+
+// Contadores de un CPU simulado
+struct CpuStats {
+    long long clock;          // Reloj virtual propio del CPU
+    long long busy;           // Unidades ejecutando procesos
+    long long dispatches;
+    long long steals;         // Procesos robados a otro CPU
+    long long failedSteals;   // Veces que quedó ocioso sin nada listo que robar
+    long long migrations;     // Turnos en un CPU distinto del anterior
+};
+
+// Resultado de una simulación con varios CPUs
+struct SmpSummary {
+    int cpus;
+    int processes;
+    long long makespan;       // Reloj del CPU que termina último
+    double utilization;       // Tiempo ocupado / (CPUs × makespan)
+    double imbalance;         // Tiempo ocupado del CPU más cargado / media
+    double wallSeconds;
+    std::vector<CpuStats> perCpu;
 };
 
 class ProcessManager {
 private:
+    // Pool de registros: las ranuras de procesos terminados (pid -1) se reutilizan
     std::vector<Process> processes;
-    std::queue<int> readyQueue;
+    std::vector<int> freeSlots;
+    std::unordered_map<int, int> pidIndex;   // pid -> ranura
+    ReadyList readyList;   // Ranuras listas, en orden de llegada a la cola
+    // SJF: los listos también van en un montículo con borrado perezoso
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> sjfHeap;
+    long long readySeq;
     MemoryManager *memoryManager;
     SchedulerType schedulerType;
     int timeQuantum;
+    int adaptivePercentile;   // RR: percentil objetivo de las ráfagas restantes (0 = quantum fijo)
+    QuantumTuner rrTuner;     // Quantum adaptativo del planificador interactivo
+    int contextSwitchCost;    // Unidades que cuesta cada cambio de contexto en la simulación
     std::mutex mtx;
     std::condition_variable cv;
     bool schedulerRunning;
     std::thread schedulerThread;
 
     int findIndexByPid(int pid) const;
-    void scheduleRR();
-    void scheduleSJF();
+    int allocSlot(const Process& p);
+    void freeSlot(int idx);
+    void pushReady(int pid);
+    void removeReady(int idx);
+    void clearReady();
+    void rebuildSjfHeap();
+    void rebuildCfsTree();
+    void scheduleRR(std::unique_lock<std::mutex>& lock);
+    void scheduleSJF(std::unique_lock<std::mutex>& lock);
+    void scheduleMLFQ(std::unique_lock<std::mutex>& lock);
+    void scheduleCFS(std::unique_lock<std::mutex>& lock);
+    void dispatch(std::unique_lock<std::mutex>& lock);
+    bool hasReadyWork() const;
+    void notifyReady();
     void schedulerLoop();
     void executeProcessInternal(int pid);
     bool autoExecute;
 
+    // Tiempo virtual: la CPU simulada avanza el reloj en lugar de dormir
+    long long virtualTime;
+    int pacingMs;   // ms reales por unidad virtual (0 = sin esperas)
+    void advanceClock(std::unique_lock<std::mutex>& lock, int units);
+
+    // Despertar del planificador y tiempo con el cerrojo tomado
+    SchedulerStats schedulerStats;
+    bool readyPending;       // Hay un proceso listo que el planificador aún no atendió
+    std::chrono::steady_clock::time_point readySince;
+    std::chrono::steady_clock::time_point lockedSince;
+    void recordHold();
+
+    // MLFQ: una cola por nivel de prioridad (0 = más alta). Los listos están además
+    // en la lista de su nivel y el bit "nivel" de mlfqMask indica que no está vacía
+    static constexpr int MLFQ_LEVELS = 4;
+    int mlfqQuanta[MLFQ_LEVELS];
+    ReadyList mlfqReady[MLFQ_LEVELS];
+    unsigned mlfqMask;
+    int boostInterval;       // Cada cuántas unidades todos vuelven al nivel 0
+    long long lastBoost;
+    int levelQuantum(const Process& p) const;
+
+    // CFS: peso por prioridad, latencia objetivo y granularidad mínima
+    static const int cfsWeights[4];
+    int cfsTargetLatency;    // Periodo en el que todos los listos deberían correr una vez
+    int cfsMinGranularity;   // Turno mínimo, aunque haya muchos listos
+    long long cfsMinVruntime;
+    long long cfsReadyWeight;     // Suma de los pesos de la cola de listos
+    std::set<CfsEntry> cfsTree;   // Interactivo: listos por vruntime, con borrado perezoso
+    static int cfsSlice(int targetLatency, int minGranularity, int weight, long long totalWeight);
+
+    // Tiempo real: EDF o RMS, con control de admisión por utilización
+    RealTimePolicy rtPolicy;
+    bool rtAdmission;
+    static bool admitRealTime(const std::vector<Process>& tasks, RealTimePolicy policy, bool verbose);
+
+    // Parámetros de una simulación por eventos. Se copian con mtx tomado y simulate()
+    // corre sin el cerrojo: las esperas del ritmo de demostración y los fallos de
+    // página (que pueden esperar al disco del swap) no bloquean al menú ni la
+    // entrega de IO_COMPLETE
+    struct SimulationConfig {
+        SchedulerType scheduler;
+        RealTimePolicy rtPolicy;
+        int quantum;
+        int mlfqQuanta[MLFQ_LEVELS];
+        int boostInterval;
+        int adaptivePercentile;
+        int contextSwitchCost;
+        int cfsTargetLatency;
+        int cfsMinGranularity;
+        int pacingMs;
+        int pageInDelay;
+        int localityPercent;
+        MemoryManager *pager;   // Gestor donde se reproducen las referencias
+    };
+    SimulationConfig simulationConfig() const;   // Con mtx tomado
+    class EventSimulation;   // Estado de una ejecución y un manejador por tipo de evento
+    // Solo usa config y el lote; con gantt y metrics guarda además el registro
+    static SimulationSummary simulate(const SimulationConfig& config, std::vector<Process>& batch, bool verbose,
+                                      std::vector<GanttSlice>* gantt = nullptr,
+                                      std::vector<ProcessMetrics>* metrics = nullptr);
+
+    // Última simulación registrada (runSimulation y scripts), para exportar el Gantt
+    std::string lastRunLabel;
+    SimulationSummary lastSummary;
+    std::vector<GanttSlice> lastGantt;
+    std::vector<ProcessMetrics> lastMetrics;
+    void storeRun(const std::string& label, const SimulationSummary& summary, std::vector<GanttSlice>& gantt,
+                  std::vector<ProcessMetrics>& metrics);
+    void printMetrics() const;
+
+    // SMP: cada CPU con su reloj, su cola de ejecución y robo de trabajo. simulateSmp
+    // solo usa sus parámetros, así se llama sin mtx tomado
+    int migrationCost;       // Unidades que pierde un CPU al recibir un proceso de otro
+    static SmpSummary simulateSmp(std::vector<Process>& batch, int cpus, int quantum, int moveCost);
+
+    // E/S: los procesos con ioInterval > 0 piden E/S al disco del DeviceManager y se
+    // bloquean hasta que se entrega su interrupción IO_COMPLETE
+    DeviceManager *devices;
+    std::unordered_map<int, int> pendingIO;   // pid -> dato de la interrupción que lo despierta
+    int ioSeq;
+    int ioLimit(const Process& p, int units) const;
+    bool issueIO(int idx);
+    void requestDeviceIO(const Process& p);
+    bool onIOComplete(const Interrupt& irq);
+
+    // Paginación por demanda en la simulación: cada unidad de CPU de un proceso con
+    // pageSpan > 0 hace PAGE_REFS_PER_UNIT referencias; un fallo lo bloquea
+    // pageInDelay unidades en el disco y lo despierta el evento PAGE_FAULT
+    static constexpr int PAGE_REFS_PER_UNIT = 4;
+    int pageInDelay;
+    int localityPercent;     // % de referencias dentro del conjunto de trabajo
+    static int replayPages(MemoryManager& memory, Process& p, uint64_t& rng, int cpuDone, int units, int locality,
+                           long long& references);
+
 public:
     ProcessManager(MemoryManager *mm);
     ~ProcessManager();
     bool createProcess(int pid, int burstTime, int arrivalTime, int priority, int memoryRequired);
+    bool forkProcess(int parentPid, int childPid);
     bool executeProcess(int pid);
     bool suspendProcess(int pid);
     bool resumeProcess(int pid);
     bool terminateProcess(int pid);
     void listProcesses() const;
-    void setScheduler(SchedulerType type, int quantum = 2);
+    void setScheduler(SchedulerType type, int quantum = 2, bool verbose = true);
+    void setAdaptiveQuantum(int percentile, bool verbose = true);
+    void setContextSwitchCost(int units, bool verbose = true);
+    void runAdaptiveQuantumBenchmark(int processCount);
     void startScheduler();
     void stopScheduler();
     void setAutoExecute(bool enable);
+    SimulationSummary runSimulation();
+    void runSimulationBenchmark(int processCount);
+    // Simula un lote ya construido (p. ej. por WorkloadGenerator) con la política actual
+    SimulationSummary runWorkload(std::vector<Process>& batch, bool verbose = true);
+    bool runProcessScript(const std::string& path);
+    void setPacing(int msPerUnit);
+    void setBoostInterval(int units);
+    void setCfsParams(int targetLatency, int minGranularity);
+    void runCfsBenchmark(int processCount);
+    bool setRealTime(int pid, int period, int deadline);
+    void setRealTimePolicy(RealTimePolicy policy, bool admission);
+    void runRealTimeBenchmark(int taskCount);
+    SmpSummary runSmpSimulation(int cpus);
+    void runSmpBenchmark(int processCount);
+    bool setAffinity(int pid, int cpu);
+    void setMigrationCost(int units);
+    long long getVirtualTime() const;
+    SchedulerStats getSchedulerStats() const;
+    void printSchedulerStats() const;
+    void runChurnBenchmark(long long cycles, int live);
+    void runSuspendResumeBenchmark(int queued, long long operations);
+    bool exportGantt(const std::string& path) const;
+    void attachDevices(DeviceManager* deviceManager);
+    bool setIOProfile(int pid, int interval, int duration);
+    void runIOBenchmark(int processCount);
+    bool setMemoryPattern(int pid, int pageSpan, int workingSet);
+    void setPagingParams(int delay, int locality, bool verbose = true);
+    void runThrashingCurve(int frames, int workingSet, int maxLevel);
+    // Instantánea: tabla de procesos, cola de listos y parámetros de los planificadores.
+    // Al restaurar, el proceso que estaba en ejecución vuelve a la cola y los bloqueados
+    // piden otra vez su E/S
+    void saveState(SnapshotWriter& out);
+    bool loadState(SnapshotReader& in, std::function<void()>& commit);
 };
 
 #endif
\ No newline at end of file
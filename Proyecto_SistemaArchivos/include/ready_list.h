@@ -0,0 +1,41 @@
+//ready_list.h
+#ifndef READY_LIST_H
+#define READY_LIST_H
+
+#include <vector>
+#include <cstddef>
+
+// Cola de listos como lista doblemente enlazada sobre las ranuras de la tabla de
+// procesos: los enlaces de la ranura i están en links[i], así encolar, desencolar
+// y quitar cualquier ranura son O(1) y recorrerla no reserva memoria. Cada ranura
+// está a lo sumo una vez en la lista.
+class ReadyList {
+private:
+    static const int OUTSIDE = -2;   // prev de una ranura que no está en la lista
+
+    struct Link {
+        int prev;
+        int next;
+    };
+    std::vector<Link> links;
+    int head;
+    int tail;
+    size_t count;
+
+public:
+    static const int NONE = -1;
+
+    ReadyList();
+    void reserve(size_t slots);      // Crece para cubrir las ranuras [0, slots)
+    bool contains(int slot) const;
+    bool pushBack(int slot);         // false si ya estaba
+    int popFront();                  // NONE si está vacía
+    bool remove(int slot);           // false si no estaba
+    int front() const;
+    int next(int slot) const;        // NONE al final
+    bool empty() const;
+    size_t size() const;
+    void clear();
+};
+
+#endif
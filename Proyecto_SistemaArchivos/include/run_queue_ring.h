@@ -0,0 +1,31 @@
+//run_queue_ring.h
+#ifndef RUN_QUEUE_RING_H
+#define RUN_QUEUE_RING_H
+
+#include <vector>
+#include <cstddef>
+
+// Cola de ejecución de un CPU simulado: anillo FIFO que dobla su capacidad cuando
+// se llena. El dueño encola al final; el dueño y los CPUs que roban sacan del
+// principio, así se roba el que más tiempo lleva esperando. La simulación SMP la
+// usa desde un único hilo, por eso no lleva sincronización
+class RunQueueRing {
+private:
+    std::vector<int> buffer;   // Capacidad potencia de 2
+    size_t head;
+    size_t count;
+
+    void grow();
+
+public:
+    static const int EMPTY = -1;
+
+    explicit RunQueueRing(size_t capacity = 16);
+    void push(int value);
+    int pop();                 // EMPTY si está vacía
+    int front() const;         // EMPTY si está vacía
+    size_t size() const;
+    bool empty() const;
+};
+
+#endif
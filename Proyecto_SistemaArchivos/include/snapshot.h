@@ -0,0 +1,118 @@
+//snapshot.h
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+#include <functional>
+#include <memory>
+
+class FileSystem;
+class ProcessManager;
+class MemoryManager;
+class DiskScheduler;
+class DeviceManager;
+
+// Escritura de una instantánea: valores y arreglos de tipos triviales se copian tal
+// cual están en memoria, de un solo write. El formato es el de la máquina que lo
+// escribe (la cabecera guarda el orden de bytes para rechazar otra arquitectura)
+class SnapshotWriter {
+private:
+    std::ostream& out;
+    std::streampos sectionStart;
+
+public:
+    explicit SnapshotWriter(std::ostream& stream);
+
+    template <typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "solo tipos triviales");
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    // Sin prefijo de longitud: para escribir un arreglo por tramos
+    template <typename T>
+    void putRaw(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "solo tipos triviales");
+        if (count > 0) out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(sizeof(T) * count));
+    }
+    template <typename T>
+    void putVector(const std::vector<T>& values) {
+        put<uint64_t>(values.size());
+        putRaw(values.data(), values.size());
+    }
+    void putString(const std::string& text);
+    void beginSection(uint32_t tag);   // Etiqueta y longitud, que se completa al cerrarla
+    void endSection();
+    bool good() const;
+};
+
+// Lectura de una instantánea, sección a sección: ninguna lectura pasa del final de
+// la sección en curso, así una longitud corrupta no reserva memoria de más
+class SnapshotReader {
+private:
+    std::istream& in;
+    uint64_t remaining;   // Bytes que quedan en la sección actual
+    bool ok;
+
+    bool take(uint64_t bytes);
+
+public:
+    explicit SnapshotReader(std::istream& stream);
+
+    template <typename T>
+    bool get(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "solo tipos triviales");
+        if (!take(sizeof(T))) return false;
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        ok = ok && in.good();
+        return ok;
+    }
+    template <typename T>
+    bool getRaw(T* values, uint64_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "solo tipos triviales");
+        if (count > remaining / sizeof(T) || !take(sizeof(T) * count)) return fail();
+        if (count > 0) in.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(sizeof(T) * count));
+        ok = ok && in.good();
+        return ok;
+    }
+    template <typename T>
+    bool getVector(std::vector<T>& values) {
+        uint64_t count;
+        if (!get(count) || count > remaining / sizeof(T)) return fail();
+        values.resize(count);
+        return getRaw(values.data(), count);
+    }
+    // Número de elementos que siguen, acotado por lo que queda de la sección
+    bool getCount(uint64_t& count, size_t minBytesEach);
+    bool getString(std::string& text);
+    bool beginSection(uint32_t tag);
+    bool endSection();   // false si la sección no se leyó completa
+    bool fail();         // Marca la instantánea como inválida; devuelve false
+    bool good() const;
+};
+
+// loadState de cada gestor lee y valida su sección sin tocar su estado y deja en
+// commit el cambio; como std::function copia, los datos leídos van en un shared_ptr
+template <typename F>
+std::function<void()> makeSnapshotCommit(F&& apply) {
+    auto staged = std::make_shared<std::decay_t<F>>(std::forward<F>(apply));
+    return [staged]() { (*staged)(); };
+}
+
+// Guarda y restaura el estado de todos los gestores en un archivo binario con
+// versión. Cada gestor escribe su propia sección; al restaurar se leen y validan
+// todas y solo si lo son se aplican, así un error no deja un estado mezclado
+class Snapshot {
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    static bool save(const std::string& path, FileSystem& fs, ProcessManager& pm, MemoryManager& mm,
+                     DiskScheduler& disk, DeviceManager& devices);
+    static bool load(const std::string& path, FileSystem& fs, ProcessManager& pm, MemoryManager& mm,
+                     DiskScheduler& disk, DeviceManager& devices);
+};
+
+#endif
@@ -0,0 +1,37 @@
+//swap_space.h
+#ifndef SWAP_SPACE_H
+#define SWAP_SPACE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Área de intercambio respaldada por un archivo local, dividida en ranuras de
+// una página. Las ranuras se asignan desde el gestor de memoria; la lectura y
+// escritura del archivo la realiza el hilo del dispositivo de disco.
+class SwapSpace {
+private:
+    std::fstream file;
+    std::string path;
+    std::unordered_map<uint64_t, int> slots;   // (proceso, página) -> ranura
+    std::vector<int> freeSlots;
+    int nextSlot;
+
+public:
+    static const int PAGE_SIZE = 4096;
+
+    SwapSpace(const std::string& path);
+    ~SwapSpace();
+    bool isOpen() const;
+    const std::string& getPath() const;
+    int slotFor(uint64_t key) const;           // -1 si la página nunca se escribió
+    int assignSlot(uint64_t key);
+    void releaseProcess(int processId);
+    int usedSlots() const;
+    bool writeSlot(int slot, int processId, int virtualPage);
+    bool readSlot(int slot, int processId, int virtualPage);
+};
+
+#endif
@@ -0,0 +1,51 @@
+//sweep_runner.h
+#ifndef SWEEP_RUNNER_H
+#define SWEEP_RUNNER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "process_manager.h"
+#include "memory_manager.h"
+
+// Barrido de parámetros: el producto de quanta × políticas × marcos × semillas
+struct SweepSpec {
+    SchedulerType scheduler = SchedulerType::RR;
+    std::vector<int> quanta;
+    std::vector<PageReplacement> policies;
+    std::vector<int> frames;
+    std::vector<uint64_t> seeds;
+    // Carga de cada configuración (WorkloadGenerator con la semilla del punto)
+    int processes = 200;
+    double meanGap = 10.0;
+    double meanBurst = 8.0;
+    double alpha = 1.5;
+    int pageSpan = 24;          // Páginas que recorre cada proceso (0 = no referencia memoria)
+    int workingSet = 8;
+    int pageInDelay = 5;
+    int locality = 90;
+    int window = 5;             // Ventana del Working Set
+    int switchCost = 0;         // Unidades por cambio de contexto
+    int threads = 0;            // 0 = un hilo por núcleo
+};
+
+// Métricas de una configuración del barrido (una fila del CSV)
+struct SweepPoint {
+    int quantum;
+    PageReplacement policy;
+    int frames;
+    uint64_t seed;
+    SimulationSummary summary;
+};
+
+// Ejecuta cada configuración con sus propios gestores en un grupo de hilos. Cada
+// punto depende solo de sus parámetros y de su semilla, y las filas se escriben en
+// el orden del barrido: el CSV es el mismo con cualquier número de hilos
+class SweepRunner {
+public:
+    static bool loadSpec(const std::string& path, SweepSpec& spec);
+    static SweepPoint runPoint(const SweepSpec& spec, int quantum, PageReplacement policy, int frames, uint64_t seed);
+    static bool run(const SweepSpec& spec, const std::string& csvPath);
+};
+
+#endif
@@ -0,0 +1,65 @@
+//workload_generator.h
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <vector>
+#include <random>
+#include <cstdint>
+#include "process_manager.h"
+#include "memory_manager.h"
+#include "disk_scheduler.h"
+
+// Generador de carga sintética reproducible: la misma semilla da la misma carga en
+// cualquier compilador (no usa las distribuciones de <random>, que dependen de la
+// biblioteca). Los lotes se entregan directamente a los gestores, sin archivos de texto.
+class WorkloadGenerator {
+private:
+    uint64_t seed;
+    std::mt19937_64 rng;
+
+    // Referencias a páginas: popularidad Zipf por proceso y cambios de fase que
+    // desplazan el conjunto caliente
+    int pageProcesses;
+    int pagesPerProcess;
+    double zipfExponent;
+    long long phaseLength;
+    int writePercent;
+    std::vector<double> zipfCdf;
+    std::vector<int> phaseOffset;    // Desplazamiento del conjunto caliente de cada proceso
+    long long refsInPhase;
+    int currentProcess;
+    int refsLeftInTurn;              // Referencias hasta el siguiente cambio de contexto
+
+    // Solicitudes de disco: recorridos secuenciales mezclados con saltos aleatorios
+    int diskTracks;
+    int sequentialPercent;
+    int lastTrack;
+
+    double uniform();                // En (0, 1]
+    int zipfRank();
+    void buildZipf();
+
+public:
+    explicit WorkloadGenerator(uint64_t seed = 42);
+    void reseed(uint64_t newSeed);   // Reinicia también el estado de los flujos
+    uint64_t getSeed() const;
+
+    // Llegadas de Poisson (huecos exponenciales de media meanGap) y ráfagas de Pareto
+    // con media meanBurst; alpha cerca de 1 da una cola más pesada
+    std::vector<Process> makeProcesses(int count, double meanGap = 10.0, double meanBurst = 8.0,
+                                       double alpha = 1.5, int firstPid = 1);
+
+    void setPageLocality(int processes, int pages, double zipfS, long long phase, int writes = 10);
+    void nextPageRefs(std::vector<PageRef>& out, size_t count);       // Continúa el flujo
+
+    void setDiskPattern(int tracks, int sequential);
+    void nextDiskRequests(std::vector<DiskRequest>& out, size_t count, int processes = 16);
+
+    // Alimentan cada gestor por lotes y muestran el ritmo obtenido
+    SimulationSummary feedProcesses(ProcessManager& pm, int count);
+    AccessResult feedMemory(MemoryManager& mm, long long refs);
+    long long feedDisk(const DiskScheduler& disk, long long requests, DiskAlgorithm algorithm, int queueDepth = 64);
+    void runStress(ProcessManager& pm, MemoryManager& mm, const DiskScheduler& disk, long long events);
+};
+
+#endif
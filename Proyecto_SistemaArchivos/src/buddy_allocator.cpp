@@ -0,0 +1,140 @@
+//buddy_allocator.cpp
+#include "buddy_allocator.h"
+#include "snapshot.h"
+
+BuddyAllocator::BuddyAllocator(int frames) {
+    init(frames);
+}
+
+void BuddyAllocator::init(int frames) {
+    totalFrames = frames;
+    maxOrder = 0;
+    while ((2 << maxOrder) <= frames) maxOrder++;
+    freeFrames = 0;
+    freeHead.assign(maxOrder + 1, -1);
+    prev.assign(frames, -1);
+    next.assign(frames, -1);
+    freeOrder.assign(frames, -1);
+
+    // Si el total no es potencia de dos se reparte en los mayores bloques alineados
+    int start = 0;
+    for (int order = maxOrder; order >= 0; --order) {
+        while (start + (1 << order) <= frames && (start & ((1 << order) - 1)) == 0) {
+            pushFree(start, order);
+            freeFrames += 1 << order;
+            start += 1 << order;
+        }
+    }
+}
+
+void BuddyAllocator::pushFree(int start, int order) {
+    freeOrder[start] = order;
+    prev[start] = -1;
+    next[start] = freeHead[order];
+    if (freeHead[order] != -1) prev[freeHead[order]] = start;
+    freeHead[order] = start;
+}
+
+void BuddyAllocator::removeFree(int start) {
+    int order = freeOrder[start];
+    if (prev[start] != -1) next[prev[start]] = next[start];
+    else freeHead[order] = next[start];
+    if (next[start] != -1) prev[next[start]] = prev[start];
+    freeOrder[start] = -1;
+}
+
+int BuddyAllocator::allocate(int order) {
+    if (order < 0 || order > maxOrder) return -1;
+
+    int current = order;
+    while (current <= maxOrder && freeHead[current] == -1) current++;
+    if (current > maxOrder) return -1;
+
+    int start = freeHead[current];
+    removeFree(start);
+
+    // Dividir hasta el orden pedido; la mitad superior vuelve a la lista libre
+    while (current > order) {
+        current--;
+        pushFree(start + (1 << current), current);
+    }
+    freeFrames -= 1 << order;
+    return start;
+}
+
+void BuddyAllocator::free(int start, int order) {
+    freeFrames += 1 << order;
+    while (order < maxOrder) {
+        int buddy = start ^ (1 << order);
+        if (buddy + (1 << order) > totalFrames || freeOrder[buddy] != order) break;
+        removeFree(buddy);
+        start = start < buddy ? start : buddy;
+        order++;
+    }
+    pushFree(start, order);
+}
+
+int BuddyAllocator::orderFor(int frames) {
+    int order = 0;
+    while ((1 << order) < frames) order++;
+    return order;
+}
+
+int BuddyAllocator::getFreeFrames() const {
+    return freeFrames;
+}
+
+int BuddyAllocator::getMaxOrder() const {
+    return maxOrder;
+}
+
+int BuddyAllocator::largestFreeBlock() const {
+    for (int order = maxOrder; order >= 0; --order) {
+        if (freeHead[order] != -1) return 1 << order;
+    }
+    return 0;
+}
+
+int BuddyAllocator::freeBlocksOfOrder(int order) const {
+    int count = 0;
+    for (int block = freeHead[order]; block != -1; block = next[block]) count++;
+    return count;
+}
+
+// Las listas libres se guardan tal cual: restaurar no recorre los bloques
+void BuddyAllocator::saveState(SnapshotWriter& out) const {
+    out.put(totalFrames);
+    out.put(freeFrames);
+    out.putVector(freeHead);
+    out.putVector(prev);
+    out.putVector(next);
+    out.putVector(freeOrder);
+}
+
+bool BuddyAllocator::loadState(SnapshotReader& in, int frames) {
+    BuddyAllocator loaded;
+    if (!in.get(loaded.totalFrames) || !in.get(loaded.freeFrames) || !in.getVector(loaded.freeHead) ||
+        !in.getVector(loaded.prev) || !in.getVector(loaded.next) || !in.getVector(loaded.freeOrder)) {
+        return false;
+    }
+    loaded.maxOrder = 0;
+    while ((2 << loaded.maxOrder) <= frames) loaded.maxOrder++;
+    size_t size = static_cast<size_t>(frames);
+    if (loaded.totalFrames != frames || loaded.freeFrames < 0 || loaded.freeFrames > frames ||
+        loaded.freeHead.size() != static_cast<size_t>(loaded.maxOrder) + 1 || loaded.prev.size() != size ||
+        loaded.next.size() != size || loaded.freeOrder.size() != size) {
+        return in.fail();
+    }
+    auto inRange = [frames](int frame) { return frame >= -1 && frame < frames; };
+    for (int head : loaded.freeHead) {
+        if (!inRange(head)) return in.fail();
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (!inRange(loaded.prev[i]) || !inRange(loaded.next[i]) || loaded.freeOrder[i] < -1 ||
+            loaded.freeOrder[i] > loaded.maxOrder) {
+            return in.fail();
+        }
+    }
+    *this = std::move(loaded);
+    return true;
+}
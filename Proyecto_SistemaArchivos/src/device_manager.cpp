@@ -1,8 +1,10 @@
 //device_manager.cpp
 #include "device_manager.h"
 #include <random>
+#include "snapshot.h"
 
 DeviceManager::DeviceManager() : running(true), verboseMode(false) {
+    interruptHandlers.resize(5);
     deviceQueues.resize(4);
     deviceBusy.resize(4, false);
     
@@ -69,14 +71,23 @@ void DeviceManager::deviceWorker(int deviceIndex) {
                 std::cout << "🔄 " << deviceName << " procesando solicitud del proceso " << request.processId << "...\n";
             }
             
-            std::this_thread::sleep_for(std::chrono::milliseconds(request.duration));
+            if (request.duration > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(request.duration));
+            }
+            if (request.transfer) {
+                request.transfer();
+            }
             
             if (verboseMode) {
                 std::cout << "✅ " << deviceName << " completó solicitud del proceso " << request.processId << "\n";
             }
             
             // Generar interrupción de forma silenciosa
-            generateInterruptSilent(InterruptType::IO_COMPLETE, request.processId, deviceIndex);
+            generateInterruptSilent(request.completion, request.processId,
+                                    request.completionData != -1 ? request.completionData : deviceIndex);
+            if (request.onComplete) {
+                request.onComplete();
+            }
             
             deviceBusy[deviceIndex] = false;
         }
@@ -92,13 +103,7 @@ bool DeviceManager::requestIO(int processId, DeviceType device, const std::strin
     }
     
     IORequest request{processId, device, data, priority, duration};
-    
-    {
-        std::lock_guard<std::mutex> lock(*deviceMutexes[deviceIndex]);
-        deviceQueues[deviceIndex].push(request);
-    }
-    
-    deviceCVs[deviceIndex]->notify_one();
+    submitIO(request);
     
     std::string deviceName;
     switch (device) {
@@ -113,6 +118,18 @@ bool DeviceManager::requestIO(int processId, DeviceType device, const std::strin
     return true;
 }
 
+bool DeviceManager::submitIO(const IORequest& request) {
+    int deviceIndex = static_cast<int>(request.device);
+    if (deviceIndex < 0 || deviceIndex >= 4) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(*deviceMutexes[deviceIndex]);
+        deviceQueues[deviceIndex].push(request);
+    }
+    deviceCVs[deviceIndex]->notify_one();
+    return true;
+}
+
 void DeviceManager::listDeviceQueues() const {
     std::cout << "\n--- COLAS DE DISPOSITIVOS ---\n";
     std::vector<std::string> deviceNames = {"Impresora", "Disco", "Red", "Teclado"};
@@ -146,6 +163,7 @@ void DeviceManager::generateInterrupt(InterruptType type, int processId, int dat
         case InterruptType::IO_COMPLETE: typeName = "IO_COMPLETE"; break;
         case InterruptType::PAGE_FAULT: typeName = "PAGE_FAULT"; break;
         case InterruptType::SYSTEM_CALL: typeName = "SYSTEM_CALL"; break;
+        case InterruptType::SWAP_OUT: typeName = "SWAP_OUT"; break;
     }
     
     std::cout << "⚠️  INTERRUPCIÓN generada: " << typeName << " para proceso " << processId << "\n";
@@ -153,10 +171,21 @@ void DeviceManager::generateInterrupt(InterruptType type, int processId, int dat
 
 // NUEVA FUNCIÓN: Generar interrupción sin mensaje
 void DeviceManager::generateInterruptSilent(InterruptType type, int processId, int data) {
+    {
+        // Quitar el manejador espera a que termine la entrega en curso
+        std::lock_guard<std::mutex> lock(handlerMutex);
+        const auto& handler = interruptHandlers[static_cast<int>(type)];
+        if (handler && handler(Interrupt{type, processId, data})) return;
+    }
     std::lock_guard<std::mutex> lock(interruptMutex);
     interruptQueue.push(Interrupt{type, processId, data});
 }
 
+void DeviceManager::setInterruptHandler(InterruptType type, std::function<bool(const Interrupt&)> handler) {
+    std::lock_guard<std::mutex> lock(handlerMutex);
+    interruptHandlers[static_cast<int>(type)] = std::move(handler);
+}
+
 void DeviceManager::processNextInterrupt() {
     std::lock_guard<std::mutex> lock(interruptMutex);
     
@@ -188,6 +217,10 @@ void DeviceManager::processNextInterrupt() {
             typeName = "SYSTEM_CALL";
             std::cout << "📞 Procesando system call del proceso " << interrupt.processId << "\n";
             break;
+        case InterruptType::SWAP_OUT:
+            typeName = "SWAP_OUT";
+            std::cout << "💾 Procesando fin de escritura al swap - Página " << interrupt.data << "\n";
+            break;
     }
     
     std::cout << "✅ Interrupción " << typeName << " procesada\n";
@@ -213,6 +246,7 @@ void DeviceManager::showInterruptStatus() const {
             case InterruptType::IO_COMPLETE: typeName = "IO_COMPLETE"; break;
             case InterruptType::PAGE_FAULT: typeName = "PAGE_FAULT"; break;
             case InterruptType::SYSTEM_CALL: typeName = "SYSTEM_CALL"; break;
+            case InterruptType::SWAP_OUT: typeName = "SWAP_OUT"; break;
         }
         
         std::cout << count << ". " << typeName << " - Proceso: " << temp.front().processId << "\n";
@@ -228,4 +262,95 @@ void DeviceManager::setVerboseMode(bool verbose) {
     } else {
         std::cout << "🔇 Modo silencioso activado - Dispositivos trabajan en segundo plano\n";
     }
-}
\ No newline at end of file
+}
+
+// Solo se guardan las solicitudes sin callbacks ni dato de interrupción propio
+static bool isPlainRequest(const IORequest& request) {
+    return !request.transfer && !request.onComplete && request.completionData == -1;
+}
+
+static bool validInterruptType(InterruptType type) {
+    return static_cast<int>(type) >= 0 && static_cast<int>(type) <= static_cast<int>(InterruptType::SWAP_OUT);
+}
+
+void DeviceManager::saveState(SnapshotWriter& out) const {
+    out.put(verboseMode);
+    out.put<uint64_t>(deviceQueues.size());
+    for (size_t i = 0; i < deviceQueues.size(); ++i) {
+        std::vector<IORequest> plain;
+        {
+            std::lock_guard<std::mutex> lock(*deviceMutexes[i]);
+            std::queue<IORequest> temp = deviceQueues[i];
+            while (!temp.empty()) {
+                if (isPlainRequest(temp.front())) plain.push_back(temp.front());
+                temp.pop();
+            }
+        }
+        out.put<uint64_t>(plain.size());
+        for (const IORequest &request : plain) {
+            out.put(request.processId);
+            out.put(request.priority);
+            out.put(request.duration);
+            out.put(request.completion);
+            out.putString(request.data);
+        }
+    }
+
+    std::vector<Interrupt> pending;
+    {
+        std::lock_guard<std::mutex> lock(interruptMutex);
+        std::queue<Interrupt> temp = interruptQueue;
+        while (!temp.empty()) {
+            pending.push_back(temp.front());
+            temp.pop();
+        }
+    }
+    out.putVector(pending);
+}
+
+bool DeviceManager::loadState(SnapshotReader& in, std::function<void()>& commit) {
+    bool verbose;
+    uint64_t devices;
+    if (!in.get(verbose) || !in.get(devices) || devices != deviceQueues.size()) return in.fail();
+    std::vector<std::vector<IORequest>> loaded(devices);
+    for (size_t i = 0; i < devices; ++i) {
+        uint64_t count;
+        if (!in.getCount(count, 3 * sizeof(int) + sizeof(InterruptType) + sizeof(uint64_t))) return false;
+        loaded[i].resize(count);
+        for (IORequest &request : loaded[i]) {
+            request.device = static_cast<DeviceType>(i);
+            if (!in.get(request.processId) || !in.get(request.priority) || !in.get(request.duration) ||
+                !in.get(request.completion) || !in.getString(request.data)) {
+                return false;
+            }
+            if (!validInterruptType(request.completion)) return in.fail();
+        }
+    }
+    std::vector<Interrupt> pending;
+    if (!in.getVector(pending)) return false;
+    for (const Interrupt &irq : pending) {
+        if (!validInterruptType(irq.type)) return in.fail();
+    }
+
+    commit = makeSnapshotCommit([this, verbose, loaded = std::move(loaded), pending = std::move(pending)]() mutable {
+        verboseMode = verbose;
+        for (size_t i = 0; i < loaded.size(); ++i) {
+            {
+                std::lock_guard<std::mutex> lock(*deviceMutexes[i]);
+                std::queue<IORequest> queue;
+                while (!deviceQueues[i].empty()) {
+                    if (deviceQueues[i].front().onComplete) queue.push(deviceQueues[i].front());
+                    deviceQueues[i].pop();
+                }
+                for (IORequest &request : loaded[i]) queue.push(std::move(request));
+                deviceQueues[i].swap(queue);
+            }
+            deviceCVs[i]->notify_one();
+        }
+        std::lock_guard<std::mutex> lock(interruptMutex);
+        std::queue<Interrupt> queue;
+        for (const Interrupt &irq : pending) queue.push(irq);
+        interruptQueue.swap(queue);
+    });
+    return true;
+}
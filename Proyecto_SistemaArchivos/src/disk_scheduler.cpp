@@ -1,4 +1,5 @@
 #include "disk_scheduler.h"
+#include "snapshot.h"
 
 DiskScheduler::DiskScheduler() : headPosition(0), currentAlgorithm(DiskAlgorithm::FCFS) {}
 
@@ -260,4 +261,79 @@ void DiskScheduler::compareAlgorithms() {
     } else {
         std::cout << "🎉 FCFS es el más eficiente para este caso\n";
     }
+}
+
+int DiskScheduler::getHeadPosition() const {
+    return headPosition;
+}
+
+long long DiskScheduler::serveRequests(const std::vector<DiskRequest>& batch, DiskAlgorithm algorithm, int& head) const {
+    long long totalMovement = 0;
+    if (batch.empty()) return 0;
+
+    if (algorithm == DiskAlgorithm::FCFS) {
+        for (const auto& req : batch) {
+            totalMovement += std::abs(req.track - head);
+            head = req.track;
+        }
+        return totalMovement;
+    }
+
+    std::vector<int> tracks;
+    tracks.reserve(batch.size());
+    for (const auto& req : batch) tracks.push_back(req.track);
+    std::sort(tracks.begin(), tracks.end());
+    long long right = std::lower_bound(tracks.begin(), tracks.end(), head) - tracks.begin();
+    long long left = right - 1;
+    long long count = static_cast<long long>(tracks.size());
+
+    if (algorithm == DiskAlgorithm::SSTF) {
+        // Las pistas ya atendidas forman siempre un tramo contiguo de las ordenadas:
+        // la más cercana es la vecina izquierda o la derecha (a igual distancia, la menor)
+        while (left >= 0 || right < count) {
+            bool takeLeft = right >= count || (left >= 0 && head - tracks[left] <= tracks[right] - head);
+            int next = takeLeft ? tracks[left--] : tracks[right++];
+            totalMovement += std::abs(next - head);
+            head = next;
+        }
+    } else {
+        // SCAN: hacia el final y luego hacia el inicio, como schedule()
+        for (long long i = right; i < count; ++i) {
+            totalMovement += tracks[i] - head;
+            head = tracks[i];
+        }
+        for (long long i = left; i >= 0; --i) {
+            totalMovement += std::abs(tracks[i] - head);
+            head = tracks[i];
+        }
+    }
+    return totalMovement;
+}
+
+void DiskScheduler::saveState(SnapshotWriter& out) const {
+    out.putVector(requests);
+    out.put(headPosition);
+    out.put(currentAlgorithm);
+    out.putVector(movementHistory);
+}
+
+bool DiskScheduler::loadState(SnapshotReader& in, std::function<void()>& commit) {
+    std::vector<DiskRequest> loadedRequests;
+    std::vector<int> loadedHistory;
+    int head;
+    DiskAlgorithm algorithm;
+    if (!in.getVector(loadedRequests) || !in.get(head) || !in.get(algorithm) || !in.getVector(loadedHistory)) {
+        return false;
+    }
+    if (algorithm != DiskAlgorithm::FCFS && algorithm != DiskAlgorithm::SSTF && algorithm != DiskAlgorithm::SCAN) {
+        return in.fail();
+    }
+    commit = makeSnapshotCommit([this, loadedRequests = std::move(loadedRequests), head, algorithm,
+                                 loadedHistory = std::move(loadedHistory)]() mutable {
+        requests = std::move(loadedRequests);
+        headPosition = head;
+        currentAlgorithm = algorithm;
+        movementHistory = std::move(loadedHistory);
+    });
+    return true;
 }
\ No newline at end of file
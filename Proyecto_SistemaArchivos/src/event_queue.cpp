@@ -0,0 +1,54 @@
+//event_queue.cpp
+#include "event_queue.h"
+#include <algorithm>
+
+EventQueue::EventQueue() : now(0), nextSeq(0), processed(0) {}
+
+// Comparador de std::push_heap: el evento "mayor" es el que va después
+bool EventQueue::later(const SimEvent& a, const SimEvent& b) {
+    if (a.time != b.time) return a.time > b.time;
+    if (a.type != b.type) return a.type > b.type;
+    return a.seq > b.seq;
+}
+
+long long EventQueue::schedule(long long time, EventType type, int process) {
+    heap.push_back(SimEvent{std::max(time, now), type, process, nextSeq});
+    std::push_heap(heap.begin(), heap.end(), later);
+    return nextSeq++;
+}
+
+SimEvent EventQueue::pop() {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    SimEvent event = heap.back();
+    heap.pop_back();
+    now = event.time;
+    processed++;
+    return event;
+}
+
+const SimEvent& EventQueue::peek() const {
+    return heap.front();
+}
+
+bool EventQueue::empty() const {
+    return heap.empty();
+}
+
+size_t EventQueue::size() const {
+    return heap.size();
+}
+
+long long EventQueue::getTime() const {
+    return now;
+}
+
+long long EventQueue::getProcessed() const {
+    return processed;
+}
+
+void EventQueue::clear() {
+    heap.clear();
+    now = 0;
+    nextSeq = 0;
+    processed = 0;
+}
@@ -2,6 +2,7 @@
 //file_system.cpp
 #include "file_system.h"
 #include <iostream>
+#include "snapshot.h"
 
 void FileSystem::createFile(const std::string &name, const std::string &content) {
     for (const auto &f : files) {
@@ -72,4 +73,25 @@ File* FileSystem::selectFileForWrite() {
     }
 
     return &files[opcion - 1];
-}
\ No newline at end of file
+}
+
+void FileSystem::saveState(SnapshotWriter& out) const {
+    out.put<uint64_t>(files.size());
+    for (const auto &f : files) {
+        out.putString(f.name);
+        out.putString(f.content);
+    }
+}
+
+// El tamaño se recalcula a partir del contenido
+bool FileSystem::loadState(SnapshotReader& in, std::function<void()>& commit) {
+    uint64_t count;
+    if (!in.getCount(count, 2 * sizeof(uint64_t))) return false;
+    std::vector<File> loaded(count);
+    for (auto &f : loaded) {
+        if (!in.getString(f.name) || !in.getString(f.content)) return false;
+        f.size = static_cast<int>(f.content.size());
+    }
+    commit = makeSnapshotCommit([this, loaded = std::move(loaded)]() mutable { files = std::move(loaded); });
+    return true;
+}
@@ -2,6 +2,7 @@
 #include <iostream>
 #include <string>
 #include <limits>
+#include <thread>
 #include "file_system.h"
 #include "disk_manager.h"
 #include "process_manager.h"
@@ -9,20 +10,37 @@
 #include "sync_manager.h"
 #include "disk_scheduler.h"
 #include "device_manager.h"
+#include "workload_generator.h"
+#include "snapshot.h"
+#include "sweep_runner.h"
 
 void clearInputBuffer() {
     std::cin.clear();
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 }
 
-int main() {
+// Con un argumento, arranca restaurando la instantánea de esa ruta.
+// "--barrido <especificación> <csv>" ejecuta un barrido de parámetros sin menú
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--barrido") {
+        SweepSpec spec;
+        if (argc < 4) {
+            std::cout << "Uso: " << argv[0] << " --barrido <especificación> <salida.csv>\n";
+            return 1;
+        }
+        return SweepRunner::loadSpec(argv[2], spec) && SweepRunner::run(spec, argv[3]) ? 0 : 1;
+    }
+
     FileSystem fs;
     DiskManager dm;
+    DeviceManager devManager;   // Antes que la memoria: el swap usa su disco
     MemoryManager mm;
     ProcessManager pm(&mm);
+    pm.attachDevices(&devManager);   // IO_COMPLETE despierta a los procesos bloqueados
     SyncManager sync;
     DiskScheduler diskSched;
-    DeviceManager devManager;
+
+    if (argc > 1) Snapshot::load(argv[1], fs, pm, mm, diskSched, devManager);
 
     int opcion;
 
@@ -46,7 +64,9 @@ int main() {
         std::cout << "16. Planificación de Disco\n";
         std::cout << "17. Gestión de Dispositivos\n";
         std::cout << "18. Gestión de Interrupciones\n";
-        std::cout << "19. Salir\n";
+        std::cout << "20. Carga sintética (estrés)\n";
+        std::cout << "21. Guardar/restaurar estado (instantánea)\n";
+        std::cout << "19. Salir\n";   // Conserva su número para los scripts de entrada
         std::cout << "Seleccione una opción: ";
         
         if (!(std::cin >> opcion)) {
@@ -57,7 +77,7 @@ int main() {
         clearInputBuffer();
         
         std::string nombre, contenido;
-        int prioridad, rafaga, pid, llegada, memreq;
+        int prioridad, rafaga, pid, llegada, memreq, padre;
 
         switch (opcion) {
             case 1:
@@ -103,6 +123,14 @@ int main() {
                     std::cout << "❌ ID inválido. Debe ser un número entero.\n";
                     break;
                 }
+                std::cout << "Fork desde el proceso (ID del padre, -1 = proceso nuevo): ";
+                if (!(std::cin >> padre)) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                if (padre != -1) {
+                    // El hijo hereda los datos del padre y comparte su memoria con copy-on-write
+                    clearInputBuffer();
+                    pm.forkProcess(padre, pid);
+                    break;
+                }
                 std::cout << "Burst time (tiempo total de CPU): ";
                 if (!(std::cin >> rafaga)) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
                 std::cout << "Tiempo de llegada: ";
@@ -170,6 +198,31 @@ int main() {
                     std::cout << "Seleccione algoritmo:\n";
                     std::cout << "1. Round Robin\n";
                     std::cout << "2. SJF (Shortest Job First)\n";
+                    std::cout << "3. Simular los procesos (motor de eventos en tiempo virtual)\n";
+                    std::cout << "4. Ritmo de simulación en tiempo real (demostraciones)\n";
+                    std::cout << "5. Benchmark del motor de eventos\n";
+                    std::cout << "6. MLFQ (colas multinivel con realimentación)\n";
+                    std::cout << "7. SRTF (SJF expropiativo)\n";
+                    std::cout << "8. Ejecutar un script de procesos (scripts/proc_*.txt)\n";
+                    std::cout << "9. Simular con varios CPUs (SMP con robo de trabajo)\n";
+                    std::cout << "10. Benchmark SMP\n";
+                    std::cout << "11. Fijar la afinidad de CPU de un proceso\n";
+                    std::cout << "12. Activar/desactivar la ejecución automática (hilo planificador)\n";
+                    std::cout << "13. Estadísticas del planificador (latencia y cerrojo)\n";
+                    std::cout << "14. Benchmark de creación/terminación de procesos\n";
+                    std::cout << "15. Exportar el diagrama de Gantt de la última simulación (CSV/JSON)\n";
+                    std::cout << "16. CFS (planificador completamente justo)\n";
+                    std::cout << "17. Benchmark CFS\n";
+                    std::cout << "18. Tiempo real: periodo y plazo de un proceso\n";
+                    std::cout << "19. Tiempo real: política (EDF/RMS) y control de admisión\n";
+                    std::cout << "20. Benchmark de tiempo real (EDF frente a RMS)\n";
+                    std::cout << "21. Benchmark de suspender/reanudar\n";
+                    std::cout << "22. E/S de un proceso (intervalo y duración)\n";
+                    std::cout << "23. Benchmark de E/S (procesos con E/S frente a solo CPU)\n";
+                    std::cout << "24. Paginación de un proceso (páginas y conjunto de trabajo)\n";
+                    std::cout << "25. Curva de thrashing (uso de CPU frente a multiprogramación)\n";
+                    std::cout << "26. Round Robin adaptativo (quantum según las ráfagas restantes)\n";
+                    std::cout << "27. Benchmark de quantum fijo frente a adaptativo\n";
                     std::cout << "Opción: ";
                     if (!(std::cin >> algo)) {
                         clearInputBuffer();
@@ -185,10 +238,364 @@ int main() {
                             break;
                         }
                         clearInputBuffer();
+                        pm.setAdaptiveQuantum(0, false);
                         pm.setScheduler(SchedulerType::RR, quantum);
                     } else if (algo == 2) {
                         clearInputBuffer();
                         pm.setScheduler(SchedulerType::SJF);
+                    } else if (algo == 3) {
+                        clearInputBuffer();
+                        pm.runSimulation();
+                    } else if (algo == 4) {
+                        int ms;
+                        std::cout << "Milisegundos reales por unidad de CPU (0 = sin esperas): ";
+                        if (!(std::cin >> ms)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setPacing(ms);
+                    } else if (algo == 5) {
+                        int cantidad;
+                        std::cout << "Número de procesos (ej. 1000000): ";
+                        if (!(std::cin >> cantidad) || cantidad <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runSimulationBenchmark(cantidad);
+                    } else if (algo == 6) {
+                        int impulso;
+                        std::cout << "Quantum del nivel 0 (se duplica en cada nivel): ";
+                        if (!(std::cin >> quantum)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Impulso de prioridad cada cuántas unidades (0 = nunca): ";
+                        if (!(std::cin >> impulso)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setBoostInterval(impulso);
+                        pm.setScheduler(SchedulerType::MLFQ, quantum);
+                    } else if (algo == 7) {
+                        clearInputBuffer();
+                        pm.setScheduler(SchedulerType::SRTF);
+                    } else if (algo == 8) {
+                        std::string ruta;
+                        std::cout << "Ruta del script (ej. scripts/proc_sjf.txt): ";
+                        std::cin >> ruta;
+                        clearInputBuffer();
+                        pm.runProcessScript(ruta);
+                    } else if (algo == 9) {
+                        int cpus, coste;
+                        std::cout << "Número de CPUs: ";
+                        if (!(std::cin >> cpus) || cpus <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Coste de migración entre CPUs (unidades): ";
+                        if (!(std::cin >> coste)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setMigrationCost(coste);
+                        pm.runSmpSimulation(cpus);
+                    } else if (algo == 10) {
+                        int cantidad;
+                        std::cout << "Número de procesos (ej. 100000): ";
+                        if (!(std::cin >> cantidad) || cantidad <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runSmpBenchmark(cantidad);
+                    } else if (algo == 11) {
+                        int pid, cpu;
+                        std::cout << "ID del proceso: ";
+                        if (!(std::cin >> pid)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "CPU (-1 = cualquiera): ";
+                        if (!(std::cin >> cpu)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setAffinity(pid, cpu);
+                    } else if (algo == 12) {
+                        char activar;
+                        std::cout << "¿Ejecutar automáticamente los procesos listos? (s/n): ";
+                        std::cin >> activar;
+                        clearInputBuffer();
+                        if (activar == 's' || activar == 'S') {
+                            pm.startScheduler();
+                            pm.setAutoExecute(true);
+                        } else {
+                            pm.setAutoExecute(false);
+                        }
+                    } else if (algo == 13) {
+                        clearInputBuffer();
+                        pm.printSchedulerStats();
+                    } else if (algo == 14) {
+                        long long ciclos;
+                        int vivos;
+                        std::cout << "Ciclos (ej. 5000000): ";
+                        if (!(std::cin >> ciclos) || ciclos <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Procesos vivos a la vez (ej. 10000): ";
+                        if (!(std::cin >> vivos) || vivos <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runChurnBenchmark(ciclos, vivos);
+                    } else if (algo == 15) {
+                        std::string ruta;
+                        std::cout << "Archivo de salida (ej. gantt.csv o gantt.json): ";
+                        std::cin >> ruta;
+                        clearInputBuffer();
+                        pm.exportGantt(ruta);
+                    } else if (algo == 16) {
+                        int latencia, granularidad;
+                        std::cout << "Latencia objetivo (ej. 20): ";
+                        if (!(std::cin >> latencia)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Granularidad mínima (ej. 2): ";
+                        if (!(std::cin >> granularidad)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setCfsParams(latencia, granularidad);
+                        pm.setScheduler(SchedulerType::CFS);
+                    } else if (algo == 17) {
+                        int cantidad;
+                        std::cout << "Número de procesos listos (ej. 100000): ";
+                        if (!(std::cin >> cantidad) || cantidad <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runCfsBenchmark(cantidad);
+                    } else if (algo == 18) {
+                        int pid, periodo, plazo;
+                        std::cout << "ID del proceso: ";
+                        if (!(std::cin >> pid)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Periodo (0 = esporádico, una sola activación): ";
+                        if (!(std::cin >> periodo)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Plazo (0 = igual al periodo; ambos 0 = clase normal): ";
+                        if (!(std::cin >> plazo)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setRealTime(pid, periodo, plazo);
+                    } else if (algo == 19) {
+                        int politicaRt;
+                        char admision;
+                        std::cout << "1. EDF (plazo más cercano)\n2. RMS (periodo más corto)\nOpción: ";
+                        if (!(std::cin >> politicaRt) || (politicaRt != 1 && politicaRt != 2)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Opción inválida.\n";
+                            break;
+                        }
+                        std::cout << "¿Rechazar conjuntos que superen la cota de utilización? (s/n): ";
+                        std::cin >> admision;
+                        clearInputBuffer();
+                        pm.setRealTimePolicy(politicaRt == 1 ? RealTimePolicy::EDF : RealTimePolicy::RMS,
+                                             admision == 's' || admision == 'S');
+                    } else if (algo == 20) {
+                        int tareas;
+                        std::cout << "Número de tareas periódicas (ej. 8): ";
+                        if (!(std::cin >> tareas) || tareas <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runRealTimeBenchmark(tareas);
+                    } else if (algo == 21) {
+                        int enCola;
+                        long long operaciones;
+                        std::cout << "Procesos en la cola de listos (ej. 100000): ";
+                        if (!(std::cin >> enCola) || enCola <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Operaciones (ej. 5000000): ";
+                        if (!(std::cin >> operaciones) || operaciones <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runSuspendResumeBenchmark(enCola, operaciones);
+                    } else if (algo == 22) {
+                        int intervalo, duracion = 0;
+                        std::cout << "PID del proceso: ";
+                        if (!(std::cin >> pid)) {
+                            clearInputBuffer();
+                            std::cout << "❌ ID inválido.\n";
+                            break;
+                        }
+                        std::cout << "Unidades de CPU entre solicitudes de E/S (0 = solo CPU): ";
+                        if (!(std::cin >> intervalo) || intervalo < 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        if (intervalo > 0) {
+                            std::cout << "Duración de cada E/S en el disco (unidades): ";
+                            if (!(std::cin >> duracion) || duracion <= 0) {
+                                clearInputBuffer();
+                                std::cout << "❌ Valor inválido.\n";
+                                break;
+                            }
+                        }
+                        clearInputBuffer();
+                        pm.setIOProfile(pid, intervalo, duracion);
+                    } else if (algo == 23) {
+                        int procesos;
+                        std::cout << "Número de procesos (ej. 100000): ";
+                        if (!(std::cin >> procesos) || procesos <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.runIOBenchmark(procesos);
+                    } else if (algo == 24) {
+                        int paginas, conjunto = 0;
+                        std::cout << "PID del proceso: ";
+                        if (!(std::cin >> pid)) {
+                            clearInputBuffer();
+                            std::cout << "❌ ID inválido.\n";
+                            break;
+                        }
+                        std::cout << "Páginas virtuales que recorre (0 = no referencia memoria): ";
+                        if (!(std::cin >> paginas) || paginas < 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        if (paginas > 0) {
+                            std::cout << "Tamaño del conjunto de trabajo (páginas): ";
+                            if (!(std::cin >> conjunto) || conjunto <= 0) {
+                                clearInputBuffer();
+                                std::cout << "❌ Valor inválido.\n";
+                                break;
+                            }
+                        }
+                        clearInputBuffer();
+                        pm.setMemoryPattern(pid, paginas, conjunto);
+                    } else if (algo == 25) {
+                        int marcos, conjunto, maxProcesos, lectura, localidad;
+                        std::cout << "Marcos de memoria (ej. 64): ";
+                        if (!(std::cin >> marcos) || marcos <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Conjunto de trabajo por proceso (ej. 12): ";
+                        if (!(std::cin >> conjunto) || conjunto <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Máximo de procesos (ej. 12): ";
+                        if (!(std::cin >> maxProcesos) || maxProcesos <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Unidades que tarda en leerse una página (ej. 5): ";
+                        if (!(std::cin >> lectura) || lectura <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "% de referencias dentro del conjunto de trabajo (ej. 90): ";
+                        if (!(std::cin >> localidad) || localidad < 0 || localidad > 100) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setPagingParams(lectura, localidad);
+                        pm.runThrashingCurve(marcos, conjunto, maxProcesos);
+                    } else if (algo == 26) {
+                        int percentil, coste;
+                        std::cout << "Quantum inicial: ";
+                        if (!(std::cin >> quantum) || quantum <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Percentil objetivo de las ráfagas restantes (1-100, ej. 80): ";
+                        if (!(std::cin >> percentil) || percentil < 1 || percentil > 100) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Coste de cada cambio de contexto (unidades, ej. 1): ";
+                        if (!(std::cin >> coste) || coste < 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setContextSwitchCost(coste);
+                        pm.setAdaptiveQuantum(percentil);
+                        pm.setScheduler(SchedulerType::RR, quantum);
+                    } else if (algo == 27) {
+                        int procesos, coste;
+                        std::cout << "Número de procesos (ej. 100000): ";
+                        if (!(std::cin >> procesos) || procesos <= 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Coste de cada cambio de contexto (unidades, ej. 1): ";
+                        if (!(std::cin >> coste) || coste < 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        pm.setContextSwitchCost(coste);
+                        pm.runAdaptiveQuantumBenchmark(procesos);
                     } else {
                         clearInputBuffer();
                         std::cout << "❌ Opción inválida.\n";
@@ -204,6 +611,7 @@ int main() {
                     std::cout << "1. FIFO\n";
                     std::cout << "2. LRU\n";
                     std::cout << "3. Working Set\n";
+                    std::cout << "4. OPT (Belady, cota inferior para trazas)\n";
                     std::cout << "Opción: ";
                     if (!(std::cin >> politica)) {
                         clearInputBuffer();
@@ -218,6 +626,8 @@ int main() {
                         mm.setReplacementPolicy(PageReplacement::LRU);
                     } else if (politica == 3) {
                         mm.setReplacementPolicy(PageReplacement::WORKING_SET);
+                    } else if (politica == 4) {
+                        mm.setReplacementPolicy(PageReplacement::OPT);
                     } else {
                         std::cout << "❌ Opción inválida.\n";
                     }
@@ -226,22 +636,201 @@ int main() {
 
             case 13:
                 {
-                    int pagina;
+                    int subopcion;
                     std::cout << "\n--- Simular Acceso a Página ---\n";
-                    std::cout << "PID del proceso: ";
-                    if (!(std::cin >> pid)) {
+                    std::cout << "1. Acceso individual\n";
+                    std::cout << "2. Reproducir traza de referencias (archivo)\n";
+                    std::cout << "3. Curva de fallos LRU (MRC) y cota OPT de una traza\n";
+                    std::cout << "4. Activar/desactivar swap en archivo\n";
+                    std::cout << "5. Benchmark de concurrencia (hits con varios CPUs)\n";
+                    std::cout << "6. Activar/desactivar páginas enormes (promoción transparente)\n";
+                    std::cout << "7. Activar/desactivar readahead (precarga de accesos secuenciales)\n";
+                    std::cout << "8. Configurar nodos NUMA (latencias y política de asignación)\n";
+                    std::cout << "Opción: ";
+                    if (!(std::cin >> subopcion)) {
                         clearInputBuffer();
-                        std::cout << "❌ PID inválido.\n";
+                        std::cout << "❌ Opción inválida.\n";
                         break;
                     }
-                    std::cout << "Número de página virtual a acceder: ";
-                    if (!(std::cin >> pagina)) {
+                    clearInputBuffer();
+
+                    if (subopcion == 1) {
+                        int pagina;
+                        std::cout << "PID del proceso: ";
+                        if (!(std::cin >> pid)) {
+                            clearInputBuffer();
+                            std::cout << "❌ PID inválido.\n";
+                            break;
+                        }
+                        std::cout << "Número de página virtual a acceder: ";
+                        if (!(std::cin >> pagina)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Página inválida.\n";
+                            break;
+                        }
                         clearInputBuffer();
-                        std::cout << "❌ Página inválida.\n";
-                        break;
+                        std::string escritura;
+                        std::cout << "¿Acceso de escritura? (s/n): ";
+                        std::getline(std::cin, escritura);
+                        mm.accessPage(pid, pagina, !escritura.empty() && (escritura[0] == 's' || escritura[0] == 'S'));
+                    } else if (subopcion == 2) {
+                        std::string ruta;
+                        std::cout << "Ruta de la traza (ej. scripts/mem_fifo.txt): ";
+                        std::getline(std::cin, ruta);
+
+                        ReferenceTrace trace;
+                        if (!MemoryManager::loadReferenceTrace(ruta, trace)) break;
+
+                        // La traza se reproduce en una memoria aislada para no alterar la actual
+                        int marcos = trace.frames > 0 ? trace.frames : mm.getTotalPages();
+                        MemoryManager traceMemory(marcos);
+                        traceMemory.setReplacementPolicy(trace.hasPolicy ? trace.policy : mm.getReplacementPolicy());
+                        if (mm.isSwapEnabled()) traceMemory.enableSwap(&devManager, mm.getSwapPath() + ".traza");
+                        if (trace.window > 0) traceMemory.setWorkingSetWindow(trace.window);
+                        int ordenEnorme = mm.getHugePageOrder();
+                        if (ordenEnorme > 0) traceMemory.enableHugePages(ordenEnorme, mm.getHugePageThreshold());
+                        if (mm.isReadaheadEnabled()) traceMemory.setReadahead(true);
+                        int nodos = mm.getNodeCount();
+                        if (nodos > 1 && traceMemory.configureNuma(nodos)) {
+                            for (int nodo = 0; nodo < nodos; ++nodo) {
+                                traceMemory.setNodeLatency(nodo, mm.getNodeLatency(nodo, false), mm.getNodeLatency(nodo, true));
+                            }
+                            traceMemory.setNumaPolicy(mm.getNumaPolicy());
+                        }
+                        AccessResult conEnormes = traceMemory.replayTrace(trace);
+                        traceMemory.showStatistics();
+
+                        if (ordenEnorme > 0) {
+                            // Misma traza solo con páginas base para comparar
+                            MemoryManager baseMemory(marcos);
+                            baseMemory.setReplacementPolicy(trace.hasPolicy ? trace.policy : mm.getReplacementPolicy());
+                            if (trace.window > 0) baseMemory.setWorkingSetWindow(trace.window);
+                            baseMemory.enableTlbModel();
+                            AccessResult base = baseMemory.accessPages(trace.refs);
+                            std::cout << "📐 Solo páginas base: " << base.faults << " fallos de página, "
+                                      << baseMemory.getTlbMisses() << " fallos de TLB\n";
+                            std::cout << "📐 Con páginas enormes: " << conEnormes.faults << " fallos de página, "
+                                      << traceMemory.getTlbMisses() << " fallos de TLB\n";
+                        }
+                    } else if (subopcion == 3) {
+                        std::string ruta;
+                        std::cout << "Ruta de la traza (ej. scripts/mem_fifo.txt): ";
+                        std::getline(std::cin, ruta);
+
+                        ReferenceTrace trace;
+                        if (!MemoryManager::loadReferenceTrace(ruta, trace)) break;
+
+                        // Una sola pasada da la tasa LRU para cualquier número de marcos
+                        mm.computeMissRatioCurve(trace.refs);
+
+                        int marcos = trace.frames > 0 ? trace.frames : mm.getTotalPages();
+                        MemoryManager optMemory(marcos);
+                        optMemory.setReplacementPolicy(PageReplacement::OPT);
+                        AccessResult opt = optMemory.accessPages(trace.refs);
+                        const std::vector<double>& curva = mm.getMissRatioCurve();
+                        double tasaOpt = trace.refs.empty() ? 0.0 : (double)opt.faults / trace.refs.size() * 100.0;
+                        double tasaLru = marcos < (int)curva.size() ? curva[marcos] * 100.0 : curva.back() * 100.0;
+                        std::cout << "🎯 Con " << marcos << " marcos -> OPT: " << opt.faults << " fallos ("
+                                  << tasaOpt << "%) | LRU: " << tasaLru << "%\n";
+
+                        mm.showStatistics();
+
+                        std::string csv;
+                        std::cout << "Exportar curva a CSV (Enter para omitir): ";
+                        std::getline(std::cin, csv);
+                        if (!csv.empty()) mm.exportMissRatioCurve(csv);
+                    } else if (subopcion == 4) {
+                        if (mm.isSwapEnabled()) {
+                            mm.disableSwap();
+                            std::cout << "💾 Swap desactivado\n";
+                            break;
+                        }
+                        std::string ruta;
+                        int latencia;
+                        std::cout << "Archivo de swap (ej. swap.bin): ";
+                        std::getline(std::cin, ruta);
+                        std::cout << "Latencia modelada del disco por transferencia (ms, 0 = solo E/S real): ";
+                        if (!(std::cin >> latencia) || latencia < 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        mm.enableSwap(&devManager, ruta, latencia);
+                    } else if (subopcion == 5) {
+                        int hilos;
+                        std::cout << "Número máximo de hilos (núcleos detectados: "
+                                  << std::thread::hardware_concurrency() << "): ";
+                        if (!(std::cin >> hilos) || hilos < 1) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        MemoryManager::runScalingBenchmark(hilos);
+                    } else if (subopcion == 6) {
+                        if (mm.getHugePageOrder() > 0) {
+                            mm.disableHugePages();
+                            std::cout << "🧱 Páginas enormes desactivadas (divididas en páginas base)\n";
+                            break;
+                        }
+                        int orden, umbral, intervalo;
+                        std::cout << "Orden de la página enorme (2^orden marcos; 9 = 2 MiB con páginas de 4 KiB): ";
+                        if (!(std::cin >> orden)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Porcentaje de la región residente para promoverla (1-100): ";
+                        if (!(std::cin >> umbral)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Intervalo de la pasada en segundo plano (ms, 0 = solo al reproducir trazas): ";
+                        if (!(std::cin >> intervalo) || intervalo < 0) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        mm.enableHugePages(orden, umbral, intervalo);
+                    } else if (subopcion == 7) {
+                        mm.setReadahead(!mm.isReadaheadEnabled());
+                    } else if (subopcion == 8) {
+                        int nodos, local, remota, politica;
+                        std::cout << "Número de nodos (1 = memoria uniforme): ";
+                        if (!(std::cin >> nodos)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Latencia de acceso local (ns, ej. 80): ";
+                        if (!(std::cin >> local)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Latencia de acceso remoto (ns, ej. 140): ";
+                        if (!(std::cin >> remota)) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        std::cout << "Política de asignación (1. Local primero, 2. Intercalada, 3. Ligada al nodo): ";
+                        if (!(std::cin >> politica) || politica < 1 || politica > 3) {
+                            clearInputBuffer();
+                            std::cout << "❌ Valor inválido.\n";
+                            break;
+                        }
+                        clearInputBuffer();
+                        if (!mm.configureNuma(nodos, local, remota)) break;
+                        if (politica == 1) mm.setNumaPolicy(NumaPolicy::LOCAL_FIRST);
+                        else if (politica == 2) mm.setNumaPolicy(NumaPolicy::INTERLEAVE);
+                        else mm.setNumaPolicy(NumaPolicy::BIND);
+                    } else {
+                        std::cout << "❌ Opción inválida.\n";
                     }
-                    clearInputBuffer();
-                    mm.accessPage(pid, pagina);
                 }
                 break;
 
@@ -494,8 +1083,116 @@ int main() {
                 sync.stopDining();
                 break;
 
+            case 20:
+                {
+                    int subopcion;
+                    long long semilla, cantidad;
+                    std::cout << "\n🎲 CARGA SINTÉTICA\n";
+                    std::cout << "1. Procesos (llegadas de Poisson, ráfagas de Pareto) al planificador actual\n";
+                    std::cout << "2. Referencias a páginas (Zipf con cambios de fase) a una memoria nueva\n";
+                    std::cout << "3. Solicitudes de disco con FCFS, SSTF y SCAN\n";
+                    std::cout << "4. Estrés completo de los tres gestores\n";
+                    std::cout << "5. Barrido de parámetros en paralelo (CSV)\n";
+                    std::cout << "Opción: ";
+                    if (!(std::cin >> subopcion) || subopcion < 1 || subopcion > 5) {
+                        clearInputBuffer();
+                        std::cout << "❌ Opción inválida.\n";
+                        break;
+                    }
+                    if (subopcion == 5) {
+                        std::string especificacion, salida;
+                        SweepSpec barrido;
+                        std::cout << "Archivo del barrido (p. ej. scripts/sweep_rr.txt): ";
+                        std::cin >> especificacion;
+                        std::cout << "Archivo CSV de salida: ";
+                        std::cin >> salida;
+                        clearInputBuffer();
+                        if (SweepRunner::loadSpec(especificacion, barrido)) SweepRunner::run(barrido, salida);
+                        break;
+                    }
+                    std::cout << "Semilla: ";
+                    if (!(std::cin >> semilla) || semilla < 0) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                    std::cout << (subopcion == 1 ? "Cantidad de procesos: " : subopcion == 4 ? "Eventos por gestor: "
+                                                                                             : "Cantidad de eventos: ");
+                    if (!(std::cin >> cantidad) || cantidad < 1) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                    WorkloadGenerator generador(static_cast<uint64_t>(semilla));
+
+                    if (subopcion == 1) {
+                        double hueco, rafagaMedia, alfa;
+                        std::cout << "Tiempo medio entre llegadas: ";
+                        if (!(std::cin >> hueco) || hueco < 0) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        std::cout << "Ráfaga media: ";
+                        if (!(std::cin >> rafagaMedia) || rafagaMedia < 1) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        std::cout << "Alfa de Pareto (p. ej. 1.5; menor = cola más pesada): ";
+                        if (!(std::cin >> alfa) || alfa <= 0) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        clearInputBuffer();
+                        cantidad = std::min(cantidad, 20000000LL);
+                        std::vector<Process> lote = generador.makeProcesses(static_cast<int>(cantidad), hueco, rafagaMedia, alfa);
+                        pm.runWorkload(lote);
+                    } else if (subopcion == 2) {
+                        int marcos, procesos, paginas;
+                        double zipf;
+                        long long fase;
+                        std::cout << "Marcos de la memoria: ";
+                        if (!(std::cin >> marcos) || marcos < 1) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        std::cout << "Procesos y páginas por proceso: ";
+                        if (!(std::cin >> procesos >> paginas) || procesos < 1 || paginas < 1) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        std::cout << "Exponente de Zipf (0 = uniforme, 1 = localidad típica): ";
+                        if (!(std::cin >> zipf) || zipf < 0) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        std::cout << "Referencias por fase (0 = sin cambios de fase): ";
+                        if (!(std::cin >> fase) || fase < 0) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        clearInputBuffer();
+                        // Memoria aparte: la carga no toca las páginas de los procesos del menú
+                        MemoryManager memoria(marcos);
+                        memoria.setReplacementPolicy(mm.getReplacementPolicy());
+                        generador.setPageLocality(procesos, paginas, zipf, fase);
+                        generador.feedMemory(memoria, cantidad);
+                    } else if (subopcion == 3) {
+                        int secuencial, profundidad;
+                        std::cout << "Porcentaje de solicitudes secuenciales: ";
+                        if (!(std::cin >> secuencial) || secuencial < 0 || secuencial > 100) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        std::cout << "Solicitudes en cola por lote: ";
+                        if (!(std::cin >> profundidad) || profundidad < 1) { clearInputBuffer(); std::cout << "❌ Valor inválido.\n"; break; }
+                        clearInputBuffer();
+                        std::cout << "\n";
+                        for (DiskAlgorithm algoritmo : {DiskAlgorithm::FCFS, DiskAlgorithm::SSTF, DiskAlgorithm::SCAN}) {
+                            generador.reseed(static_cast<uint64_t>(semilla));
+                            generador.setDiskPattern(200, secuencial);
+                            generador.feedDisk(diskSched, cantidad, algoritmo, profundidad);
+                        }
+                    } else {
+                        clearInputBuffer();
+                        MemoryManager memoria(1024);
+                        generador.runStress(pm, memoria, diskSched, cantidad);
+                    }
+                }
+                break;
+
+            case 21:
+                {
+                    int subopcion;
+                    std::cout << "\n💾 INSTANTÁNEA DEL SISTEMA\n";
+                    std::cout << "1. Guardar estado (archivos, procesos, memoria, disco y dispositivos)\n";
+                    std::cout << "2. Restaurar estado\n";
+                    std::cout << "Opción: ";
+                    if (!(std::cin >> subopcion) || subopcion < 1 || subopcion > 2) {
+                        clearInputBuffer();
+                        std::cout << "❌ Opción inválida.\n";
+                        break;
+                    }
+                    std::cout << "Ruta del archivo: ";
+                    std::cin >> nombre;
+                    clearInputBuffer();
+                    if (subopcion == 1) {
+                        Snapshot::save(nombre, fs, pm, mm, diskSched, devManager);
+                    } else {
+                        Snapshot::load(nombre, fs, pm, mm, diskSched, devManager);
+                    }
+                }
+                break;
+
             default:
-                std::cout << "\n❌ Opción inválida. Por favor seleccione una opción válida (1-19).\n";
+                std::cout << "\n❌ Opción inválida. Por favor seleccione una opción válida (1-21).\n";
                 break;
         }
 
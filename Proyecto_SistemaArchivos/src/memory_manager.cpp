@@ -2,217 +2,2512 @@
 #include "memory_manager.h"
 #include <iostream>
 #include <algorithm>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <unordered_map>
+#include <future>
+#include <thread>
+#include "snapshot.h"
 
-MemoryManager::MemoryManager(int total) 
-    : totalPages(total), usedPages(0), replacementPolicy(PageReplacement::FIFO), 
-      accessCounter(0), pageFaults(0), pageHits(0), workingSetWindow(5) {
+// ---------------- Page ----------------
+
+Page::Page(int page, int process)
+    : pageId(page), processId(process), referenced(false), modified(false), huge(false), prefetched(false),
+      mapCount(0), lastUsed(0) {}
+
+Page::Page(const Page& other)
+    : pageId(other.pageId), processId(other.processId), referenced(other.referenced),
+      modified(other.modified.load(std::memory_order_relaxed)),
+      huge(other.huge.load(std::memory_order_relaxed)),
+      prefetched(other.prefetched.load(std::memory_order_relaxed)),
+      mapCount(other.mapCount.load(std::memory_order_relaxed)),
+      lastUsed(other.lastUsed.load(std::memory_order_relaxed)) {}
+
+Page& Page::operator=(const Page& other) {
+    pageId = other.pageId;
+    processId = other.processId;
+    referenced = other.referenced;
+    modified.store(other.modified.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    huge.store(other.huge.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    prefetched.store(other.prefetched.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    mapCount.store(other.mapCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    lastUsed.store(other.lastUsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+// ---------------- FrameList ----------------
+
+void FrameList::init(int frames) {
+    prev.assign(frames, -2);   // -2 = fuera de la lista
+    next.assign(frames, -2);
+    head = tail = -1;
+}
+
+void FrameList::pushBack(int frame) {
+    prev[frame] = tail;
+    next[frame] = -1;
+    if (tail != -1) next[tail] = frame;
+    else head = frame;
+    tail = frame;
+}
+
+void FrameList::remove(int frame) {
+    if (prev[frame] == -2) return;
+    if (prev[frame] != -1) next[prev[frame]] = next[frame];
+    else head = next[frame];
+    if (next[frame] != -1) prev[next[frame]] = prev[frame];
+    else tail = prev[frame];
+    prev[frame] = next[frame] = -2;
+}
+
+void FrameList::moveToBack(int frame) {
+    if (frame == tail) return;
+    remove(frame);
+    pushBack(frame);
+}
+
+// ---------------- PageIndex ----------------
+
+void PageIndex::init(int capacity) {
+    size_t size = 16;
+    shift = 60;
+    while (size < static_cast<size_t>(capacity) * 2) {
+        size <<= 1;
+        shift--;
+    }
+    slots.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i) {
+        slots[i].key.store(0, std::memory_order_relaxed);
+        slots[i].frame.store(-1, std::memory_order_relaxed);
+    }
+    mask = size - 1;
+    used = 0;
+}
+
+size_t PageIndex::home(uint64_t key) const {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+}
+
+int PageIndex::find(uint64_t key) const {
+    size_t i = home(key);
+    // El límite de sondeos solo importa si un escritor mueve ranuras a la vez
+    for (size_t probes = 0; probes <= mask; ++probes) {
+        int frame = slots[i].frame.load(std::memory_order_relaxed);
+        if (frame == -1) return -1;
+        if (slots[i].key.load(std::memory_order_relaxed) == key) return frame;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+void PageIndex::insert(uint64_t key, int frame) {
+    size_t i = home(key);
+    while (slots[i].frame.load(std::memory_order_relaxed) != -1 &&
+           slots[i].key.load(std::memory_order_relaxed) != key) {
+        i = (i + 1) & mask;
+    }
+    if (slots[i].frame.load(std::memory_order_relaxed) == -1) used++;
+    slots[i].key.store(key, std::memory_order_relaxed);
+    slots[i].frame.store(frame, std::memory_order_relaxed);
+}
+
+void PageIndex::erase(uint64_t key) {
+    size_t i = home(key);
+    while (slots[i].frame.load(std::memory_order_relaxed) != -1 &&
+           slots[i].key.load(std::memory_order_relaxed) != key) {
+        i = (i + 1) & mask;
+    }
+    if (slots[i].frame.load(std::memory_order_relaxed) == -1) return;
+    used--;
+
+    // Borrado con desplazamiento hacia atrás (sin lápidas)
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        int frame = slots[j].frame.load(std::memory_order_relaxed);
+        if (frame == -1) break;
+        uint64_t movedKey = slots[j].key.load(std::memory_order_relaxed);
+        size_t k = home(movedKey);
+        bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+        if (movable) {
+            slots[i].key.store(movedKey, std::memory_order_relaxed);
+            slots[i].frame.store(frame, std::memory_order_relaxed);
+            i = j;
+        }
+    }
+    slots[i].frame.store(-1, std::memory_order_relaxed);
+}
+
+size_t PageIndex::size() const {
+    return used;
+}
+
+// Con marcos compartidos hay más claves que marcos: se mantiene la ocupación <= 1/2
+void PageIndex::reserve(size_t capacity) {
+    if (capacity * 2 <= mask + 1) return;
+    std::vector<std::pair<uint64_t, int>> entries;
+    for (size_t i = 0; i <= mask; ++i) {
+        int frame = slots[i].frame.load(std::memory_order_relaxed);
+        if (frame != -1) entries.push_back({slots[i].key.load(std::memory_order_relaxed), frame});
+    }
+    init(static_cast<int>(capacity));
+    for (const auto &[key, frame] : entries) insert(key, frame);
+}
+// ---------------- FenwickTree ----------------
+
+void FenwickTree::init(size_t size) {
+    tree.assign(size + 1, 0);
+}
+
+void FenwickTree::add(size_t position, int delta) {
+    for (size_t i = position + 1; i < tree.size(); i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+long long FenwickTree::prefixSum(size_t position) const {
+    long long sum = 0;
+    for (size_t i = position; i > 0; i -= i & (~i + 1)) {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+
+// ---------------- MemoryManager ----------------
+
+MemoryManager::MemoryManager(int total, int nodeCount) 
+    : totalPages(total), usedPages(0), residentPages(0), spareFrames(0), indexSequence(0),
+      replacementPolicy(PageReplacement::FIFO), 
+      accessCounter(0), pageFaults(0), pageHits(0), workingSetWindow(5), exclusiveWaiters(0), nodeCount(1), numaPolicy(NumaPolicy::LOCAL_FIRST),
+      sharedMappings(0), forkedPages(0), cowFaults(0),
+      hugePageOrder(0), hugePageThreshold(75), hugePages(0), hugePromotions(0), hugeSplits(0),
+      tlbEnabled(false), tlbMisses(0), daemonStop(false),
+      readaheadEnabled(false), prefetchesIssued(0), prefetchesUseful(0), prefetchesWasted(0), optActive(false), missRatioReferences(0), swapDevice(nullptr), swapLatencyMs(0),
+      pageIns(0), pageInNanos(0), writeBacks(0), writeBackNanos(0), swapErrors(0),
+      pendingSwapIO(0) {
     pageTable.resize(total);
-    for (int i = 0; i < total; ++i) {
-        pageTable[i] = Page{-1, -1, false, false, 0, std::vector<int>()};
+    frameOwner.assign(total, -1);
+    demandFrame.assign(total, 0);
+    pageIndex.init(total);
+    fifoList.init(total);
+    lruList.init(total);
+    lruStamp.assign(total, -1);
+    optNextUse.assign(total, NEVER_USED);
+    hugeStamp.assign(total, -1);
+
+    // Una caché de marcos libres por núcleo y nodo, y un TLB por núcleo
+    cpuCount = static_cast<int>(std::min(64u, std::max(1u, std::thread::hardware_concurrency())));
+    buildNodes(std::min(std::max(1, nodeCount), std::min(MAX_NODES, std::max(1, total))));
+    tlbs.reset(new CpuTlb[cpuCount]);
+    for (int cpu = 0; cpu < cpuCount; ++cpu) {
+        for (auto &tag : tlbs[cpu].tags) tag.store(TLB_EMPTY, std::memory_order_relaxed);
+    }
+}
+
+MemoryManager::~MemoryManager() {
+    stopHugePageDaemon();
+    // Las transferencias en curso apuntan a este objeto
+    waitForSwapIO();
+}
+
+uint64_t MemoryManager::makeKey(int processId, int virtualPage) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(processId)) << 32) |
+           static_cast<uint32_t>(virtualPage);
+}
+
+std::mutex& MemoryManager::stripeFor(uint64_t key) {
+    return stripeLocks[(key * 0x9E3779B97F4A7C15ULL) >> 58];   // 64 franjas
+}
+
+// Asignar/liberar y la pasada de páginas enormes se anuncian para que los lotes
+// de accesos no los dejen esperando indefinidamente
+std::unique_lock<std::shared_mutex> MemoryManager::lockTableExclusive() {
+    exclusiveWaiters++;
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    exclusiveWaiters--;
+    return table;
+}
+
+void MemoryManager::yieldToExclusive() const {
+    while (exclusiveWaiters.load(std::memory_order_relaxed) > 0) std::this_thread::yield();
+}
+
+int MemoryManager::cpuSlot(int cpu) const {
+    if (cpu >= 0) return cpu % cpuCount;
+    return static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % cpuCount);
+}
+
+// Lectura sin locks: se repite si un escritor modificó el índice mientras tanto
+int MemoryManager::lookupFrame(uint64_t key) const {
+    while (true) {
+        unsigned before = indexSequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+        int frame = pageIndex.find(key);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (indexSequence.load(std::memory_order_relaxed) == before) return frame;
+    }
+}
+
+// Escrituras del índice: siempre con replacementLock tomado
+void MemoryManager::indexInsert(uint64_t key, int frame) {
+    unsigned sequence = indexSequence.load(std::memory_order_relaxed);
+    indexSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    pageIndex.insert(key, frame);
+    indexSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void MemoryManager::indexErase(uint64_t key) {
+    unsigned sequence = indexSequence.load(std::memory_order_relaxed);
+    indexSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    pageIndex.erase(key);
+    indexSequence.store(sequence + 2, std::memory_order_release);
+}
+
+// Entrada del TLB para una etiqueta (64 entradas, correspondencia directa)
+static size_t tlbIndex(uint64_t tag) {
+    return static_cast<size_t>((tag * 0x9E3779B97F4A7C15ULL) >> 32) % CpuTlb::ENTRIES;
+}
+
+// Etiqueta de la página enorme que contiene la página de la clave
+uint64_t MemoryManager::hugeTag(uint64_t key) const {
+    uint32_t page = static_cast<uint32_t>(key);
+    return (key & 0xffffffff00000000ULL) | (page >> hugePageOrder) | HUGE_TAG;
+}
+
+// Consulta el TLB del CPU; devuelve true si la traducción no estaba y la carga.
+// Dos hilos en el mismo CPU simulado pueden pisarse una entrada: solo altera el conteo
+inline bool MemoryManager::tlbAccess(CpuTlb& tlb, uint64_t key, int frame) {
+    uint64_t tag = pageTable[frame].huge.load(std::memory_order_relaxed) ? hugeTag(key) : key;
+    std::atomic<uint64_t> &entry = tlb.tags[tlbIndex(tag)];
+    if (entry.load(std::memory_order_relaxed) == tag) return false;
+    entry.store(tag, std::memory_order_relaxed);
+    return true;
+}
+
+// Invalida la traducción en el TLB de todos los CPUs (con replacementLock)
+void MemoryManager::tlbShootdown(uint64_t tag) {
+    size_t index = tlbIndex(tag);
+    for (int cpu = 0; cpu < cpuCount; ++cpu) {
+        std::atomic<uint64_t> &entry = tlbs[cpu].tags[index];
+        uint64_t expected = tag;
+        if (entry.load(std::memory_order_relaxed) == tag) {
+            entry.compare_exchange_strong(expected, TLB_EMPTY, std::memory_order_relaxed);
+        }
+    }
+}
+
+void MemoryManager::installPage(int frame, int processId, int virtualPage, long long stamp, bool write,
+                                bool prefetch) {
+    std::lock_guard<std::mutex> lock(replacementLock);
+    mapPage(frame, processId, virtualPage, stamp, write, prefetch);
+}
+
+// Carga la página en el marco y la publica en el índice (con replacementLock)
+void MemoryManager::mapPage(int frame, int processId, int virtualPage, long long stamp, bool write,
+                            bool prefetch) {
+    Page &page = pageTable[frame];
+    page.processId = processId;
+    page.pageId = virtualPage;
+    page.referenced = true;
+    page.modified.store(write, std::memory_order_relaxed);
+    page.prefetched.store(prefetch, std::memory_order_relaxed);
+    page.lastUsed.store(stamp, std::memory_order_relaxed);
+    page.mapCount.store(1, std::memory_order_relaxed);
+
+    // Los hits sin lock solo ven la página cuando ya está completa
+    fifoList.pushBack(frame);
+    if (replacementPolicy != PageReplacement::FIFO) {
+        // lruList debe seguir ordenada: una marca anterior a la cola va al montículo
+        if (lruList.tail != -1 && stamp < lruStamp[lruList.tail]) {
+            refreshLru(frame, stamp);
+        } else {
+            lruList.pushBack(frame);
+            lruStamp[frame] = stamp;
+        }
+    }
+    indexInsert(makeKey(processId, virtualPage), frame);
+    residentPages++;
+}
+
+// Saca la página residente del marco, que queda listo para reutilizarse (con replacementLock).
+// Si estaba compartida se quitan todos sus mapeos
+void MemoryManager::evictFrame(int frame) {
+    Page &page = pageTable[frame];
+    uint64_t key = makeKey(page.processId, page.pageId);
+    bool huge = page.huge.load(std::memory_order_relaxed);
+    int mappings = page.mapCount.exchange(0, std::memory_order_relaxed);
+    if (mappings > 1) {
+        auto it = frameSharers.find(frame);
+        for (uint64_t other : it->second) {
+            if (other == key) continue;
+            indexErase(other);
+            tlbShootdown(huge ? hugeTag(other) : other);
+        }
+        frameSharers.erase(it);
+        sharedMappings -= mappings - 1;
+    }
+    indexErase(key);
+    tlbShootdown(huge ? hugeTag(key) : key);
+    if (page.prefetched.exchange(false, std::memory_order_relaxed)) prefetchWasted(page.processId, page.pageId);
+    fifoList.remove(frame);
+    lruList.remove(frame);
+    lruStamp[frame] = -1;
+    page.processId = -1;
+    page.pageId = -1;
+    page.referenced = false;
+    residentPages--;
+}
+
+// Descarta la página y libera el marco (con replacementLock)
+void MemoryManager::dropPage(int frame) {
+    evictFrame(frame);
+    releaseFrame(frame);
+}
+
+// El marco vuelve a su dueño o, si era un marco suelto, al buddy
+void MemoryManager::releaseFrame(int frame) {
+    std::lock_guard<std::mutex> lock(allocLock);
+    int owner = frameOwner[frame];
+    if (demandFrame[frame]) {
+        demandFrame[frame] = 0;
+        frameOwner[frame] = -1;
+        freeBlock(frame, 0);
+        nodes[frameNode[frame]]->exhausted = false;
+        usedPages--;
+    } else if (owner != -1) {
+        processFrames[owner].spare.push_back(frame);
+        spareFrames++;
+    }
+}
+
+// Quita un mapeo de un marco compartido; si era el que guarda pageTable, pasa
+// a ser otro de los que quedan (con replacementLock). Un marco compartido nunca es enorme
+void MemoryManager::unmapKey(int frame, uint64_t key) {
+    Page &page = pageTable[frame];
+    std::vector<uint64_t> &keys = frameSharers[frame];
+    keys.erase(std::find(keys.begin(), keys.end(), key));
+    indexErase(key);
+    tlbShootdown(key);
+    if (makeKey(page.processId, page.pageId) == key) {
+        page.processId = static_cast<int>(keys.front() >> 32);
+        page.pageId = static_cast<int>(static_cast<uint32_t>(keys.front()));
+    }
+    if (keys.size() == 1) frameSharers.erase(frame);
+    page.mapCount--;
+    sharedMappings--;
+}
+
+// Quita los mapeos del proceso sobre marcos compartidos, hasta `limit`; los marcos
+// siguen en uso por los demás procesos (tabla en exclusiva y replacementLock tomado)
+int MemoryManager::unmapSharedPages(int processId, int limit) {
+    std::vector<int> frames;
+    for (const auto &entry : frameSharers) frames.push_back(entry.first);
+    std::sort(frames.begin(), frames.end());
+    int unmapped = 0;
+    for (int frame : frames) {
+        if (unmapped >= limit) break;
+        const std::vector<uint64_t> &keys = frameSharers[frame];
+        auto it = std::find_if(keys.begin(), keys.end(),
+                               [processId](uint64_t key) { return static_cast<int>(key >> 32) == processId; });
+        if (it == keys.end()) continue;
+        unmapKey(frame, *it);
+        unmapped++;
+    }
+    return unmapped;
+}
+
+// Marco para una página nueva del proceso: primero su holgura, luego las cachés
+// del CPU de los nodos que permite la política NUMA
+int MemoryManager::takeFrame(int processId, int virtualPage, int cpu) {
+    if (spareFrames.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(allocLock);
+        auto it = processFrames.find(processId);
+        if (it != processFrames.end() && !it->second.spare.empty()) {
+            int frame = it->second.spare.back();
+            it->second.spare.pop_back();
+            spareFrames--;
+            return frame;
+        }
+    }
+
+    int candidates[MAX_NODES];
+    int count = nodeCandidates(processId, virtualPage, candidates);
+    int frame = -1;
+    for (int i = 0; i < count && frame == -1; ++i) {
+        frame = takeNodeFrame(candidates[i], cpu);
+    }
+    if (frame == -1) return -1;
+    frameOwner[frame] = processId;
+    demandFrame[frame] = 1;
+    usedPages++;
+    return frame;
+}
+
+// Marco libre del nodo desde la caché del CPU (-1 si el nodo no tiene)
+int MemoryManager::takeNodeFrame(int node, int cpu) {
+    MemoryNode &memory = *nodes[node];
+    // Con la memoria llena se evita tocar cachés y buddy en cada fallo
+    int frame = -1;
+    if (memory.cachedFrames.load(std::memory_order_relaxed) > 0) {
+        FrameCache &cache = frameCaches[cpu * nodeCount + node];
+        std::lock_guard<std::mutex> lock(cache.lock);
+        if (!cache.frames.empty()) {
+            frame = cache.frames.back();
+            cache.frames.pop_back();
+        }
+    }
+    if (frame == -1 && (!memory.exhausted.load(std::memory_order_relaxed) ||
+                        memory.cachedFrames.load(std::memory_order_relaxed) > 0)) {
+        frame = refillFrameCache(node, cpu);
+    }
+    if (frame != -1) memory.cachedFrames--;
+    return frame;
+}
+
+// Rellena la caché del CPU con un lote del buddy del nodo. Si está vacío se toma
+// un marco del mismo nodo de otra caché antes de probar otro nodo o expulsar.
+// Devuelve el marco para el fallo en curso (-1 si no queda ninguno libre).
+int MemoryManager::refillFrameCache(int node, int cpu) {
+    MemoryNode &memory = *nodes[node];
+    std::vector<int> batch;
+    {
+        std::lock_guard<std::mutex> lock(allocLock);
+        int frame;
+        while (static_cast<int>(batch.size()) < FRAME_CACHE_BATCH && (frame = memory.buddy.allocate(0)) != -1) {
+            batch.push_back(memory.firstFrame + frame);
+        }
+        memory.cachedFrames += static_cast<int>(batch.size());
+        if (batch.empty()) memory.exhausted = true;
+    }
+    if (batch.empty()) {
+        for (int other = 0; other < cpuCount; ++other) {
+            if (other == cpu) continue;
+            FrameCache &cache = frameCaches[other * nodeCount + node];
+            std::lock_guard<std::mutex> lock(cache.lock);
+            if (!cache.frames.empty()) {
+                int frame = cache.frames.back();
+                cache.frames.pop_back();
+                return frame;
+            }
+        }
+        return -1;
+    }
+
+    // Se guardan en orden inverso para entregar primero los marcos más bajos
+    FrameCache &cache = frameCaches[cpu * nodeCount + node];
+    std::lock_guard<std::mutex> lock(cache.lock);
+    cache.frames.insert(cache.frames.end(), batch.rbegin(), batch.rend() - 1);
+    return batch.front();
+}
+
+// Devuelve al buddy los marcos de las cachés para que vuelvan a fusionarse (tabla en exclusiva)
+void MemoryManager::drainFrameCaches() {
+    for (int slot = 0; slot < cpuCount * nodeCount; ++slot) {
+        for (int frame : frameCaches[slot].frames) {
+            freeBlock(frame, 0);
+        }
+        frameCaches[slot].frames.clear();
+    }
+    for (auto &node : nodes) {
+        node->cachedFrames = 0;
+        node->exhausted = false;
+    }
+}
+
+// Devuelve el bloque al buddy. Los marcos con una página de otro proceso (heredada
+// en un fork o cargada tras un reemplazo) pasan a ser marcos sueltos de ese proceso
+// (tabla en exclusiva y replacementLock tomado)
+void MemoryManager::releaseBlock(const FrameBlock& block, int processId) {
+    int size = 1 << block.order;
+    int kept = 0;
+    for (int frame = block.start; frame < block.start + size; ++frame) {
+        int user = pageTable[frame].processId;
+        if (user != -1 && user != processId) {
+            demandFrame[frame] = 1;
+            frameOwner[frame] = user;
+            kept++;
+            continue;
+        }
+        if (user != -1) evictFrame(frame);
+        frameOwner[frame] = -1;
+    }
+    if (kept == 0) {
+        freeBlock(block.start, block.order);
+    } else {
+        for (int frame = block.start; frame < block.start + size; ++frame) {
+            if (frameOwner[frame] == -1) freeBlock(frame, 0);
+        }
+    }
+    usedPages -= size - kept;
+}
+
+// Reparte los marcos en nodos de tamaño parecido (tabla en exclusiva, sin marcos asignados)
+void MemoryManager::buildNodes(int count) {
+    nodeCount = count;
+    nodes.clear();
+    frameNode.assign(totalPages, 0);
+    int first = 0;
+    for (int node = 0; node < count; ++node) {
+        auto memory = std::make_unique<MemoryNode>();
+        memory->firstFrame = first;
+        memory->frames = totalPages / count + (node < totalPages % count ? 1 : 0);
+        memory->buddy.init(memory->frames);
+        std::fill(frameNode.begin() + first, frameNode.begin() + first + memory->frames, node);
+        first += memory->frames;
+        nodes.push_back(std::move(memory));
+    }
+    frameCaches.reset(new FrameCache[cpuCount * count]);
+}
+
+int MemoryManager::homeNodeOf(int processId) const {
+    if (nodeCount == 1) return 0;
+    auto it = homeNodes.find(processId);
+    if (it != homeNodes.end()) return it->second;
+    return (processId % nodeCount + nodeCount) % nodeCount;
+}
+
+// Nodos donde puede ir la página, en orden de preferencia; devuelve cuántos son
+int MemoryManager::nodeCandidates(int processId, int virtualPage, int* candidates) const {
+    int home = homeNodeOf(processId);
+    int first = home;
+    switch (numaPolicy) {
+        case NumaPolicy::BIND:
+            candidates[0] = home;
+            return 1;
+        case NumaPolicy::INTERLEAVE:
+            first = (virtualPage % nodeCount + nodeCount) % nodeCount;
+            break;
+        case NumaPolicy::LOCAL_FIRST:
+            break;
+    }
+    for (int i = 0; i < nodeCount; ++i) candidates[i] = (first + i) % nodeCount;
+    return nodeCount;
+}
+
+// Bloque de 2^order marcos en el primer nodo candidato que lo tenga (-1 si ninguno)
+int MemoryManager::allocateBlock(int order, int processId, int virtualPage) {
+    int candidates[MAX_NODES];
+    int count = nodeCandidates(processId, virtualPage, candidates);
+    for (int i = 0; i < count; ++i) {
+        MemoryNode &memory = *nodes[candidates[i]];
+        int start = memory.buddy.allocate(order);
+        if (start != -1) return memory.firstFrame + start;
+    }
+    return -1;
+}
+
+void MemoryManager::freeBlock(int start, int order) {
+    MemoryNode &memory = *nodes[frameNode[start]];
+    memory.buddy.free(start - memory.firstFrame, order);
+}
+
+// Marcos libres en los buddies de todos los nodos (sin contar las cachés)
+int MemoryManager::freeFrameCount() const {
+    int free = 0;
+    for (const auto &node : nodes) free += node->buddy.getFreeFrames();
+    return free;
+}
+
+void MemoryManager::refreshExhausted() {
+    for (auto &node : nodes) node->exhausted = node->buddy.getFreeFrames() == 0;
+}
+
+// Bloques para `pages` páginas en el nodo (que tiene al menos esos marcos libres)
+void MemoryManager::allocateOnNode(int node, int pages, std::vector<FrameBlock>& blocks) {
+    MemoryNode &memory = *nodes[node];
+    // Un único bloque contiguo de 2^k marcos con k = ceil(log2(pages))
+    int order = BuddyAllocator::orderFor(pages);
+    int start = memory.buddy.allocate(order);
+    if (start != -1) {
+        blocks.push_back(FrameBlock{memory.firstFrame + start, order, pages});
+        return;
+    }
+
+    // Sin bloque contiguo: descomponer en potencias de dos (sin holgura)
+    size_t before = blocks.size();
+    int remaining = pages;
+    while (remaining > 0) {
+        int blockOrder = 0;
+        while ((2 << blockOrder) <= remaining) blockOrder++;
+        int blockStart = -1;
+        while (blockOrder >= 0 && (blockStart = memory.buddy.allocate(blockOrder)) == -1) blockOrder--;
+        blocks.push_back(FrameBlock{memory.firstFrame + blockStart, blockOrder, 1 << blockOrder});
+        remaining -= 1 << blockOrder;
+    }
+    std::cout << "⚠️  Sin bloque contiguo de " << (1 << order) << " marcos (fragmentación externa): "
+              << "asignación en " << blocks.size() - before << " bloques\n";
+}
+
+bool MemoryManager::allocateFrames(int pages, int processId, bool contiguousOnly) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    if (pages <= 0) {
+        std::cout << "✅ Asignadas 0 páginas al proceso " << processId << "\n";
+        return true;
+    }
+    drainFrameCaches();
+    int candidates[MAX_NODES];
+    int count = nodeCandidates(processId, 0, candidates);
+    int available = 0;
+    for (int i = 0; i < count; ++i) available += nodes[candidates[i]]->buddy.getFreeFrames();
+    if (available < pages) {
+        std::cout << "Memoria insuficiente. Necesario liberar " << (pages - available) << " páginas.\n";
+        return false;
+    }
+
+    // Páginas que recibe cada nodo: con INTERLEAVE a partes iguales entre los nodos;
+    // si no, todas en el primer nodo candidato con sitio o, si no cabe, en orden
+    std::vector<FrameBlock> blocks;
+    std::vector<int> share(nodeCount, 0);
+    if (contiguousOnly) {
+        int order = BuddyAllocator::orderFor(pages);
+        int start = allocateBlock(order, processId, 0);
+        if (start == -1) {
+            std::cout << "❌ No hay un bloque contiguo de " << (1 << order) << " marcos (fragmentación externa)\n";
+            return false;
+        }
+        blocks.push_back(FrameBlock{start, order, pages});
+        share[frameNode[start]] = pages;
+    } else {
+        if (numaPolicy == NumaPolicy::INTERLEAVE) {
+            for (int remaining = pages; remaining > 0;) {
+                for (int i = 0; i < count && remaining > 0; ++i) {
+                    int node = candidates[i];
+                    if (share[node] < nodes[node]->buddy.getFreeFrames()) {
+                        share[node]++;
+                        remaining--;
+                    }
+                }
+            }
+        } else {
+            int target = -1;
+            for (int i = 0; i < count && target == -1; ++i) {
+                if (nodes[candidates[i]]->buddy.getFreeFrames() >= pages) target = candidates[i];
+            }
+            if (target != -1) {
+                share[target] = pages;
+            } else {
+                int remaining = pages;
+                for (int i = 0; i < count && remaining > 0; ++i) {
+                    int node = candidates[i];
+                    share[node] = std::min(remaining, nodes[node]->buddy.getFreeFrames());
+                    remaining -= share[node];
+                }
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            if (share[candidates[i]] > 0) allocateOnNode(candidates[i], share[candidates[i]], blocks);
+        }
+    }
+
+    // Los primeros share[nodo] marcos de cada nodo reciben las páginas virtuales
+    // 0..pages-1: consecutivas o, con INTERLEAVE, alternando nodos página a página
+    std::vector<std::vector<int>> nodeFrames(nodeCount);
+    for (const FrameBlock &block : blocks) {
+        for (int frame = block.start; frame < block.start + (1 << block.order); ++frame) {
+            nodeFrames[frameNode[frame]].push_back(frame);
+        }
+    }
+    std::vector<int> placement;
+    std::vector<int> taken(nodeCount, 0);
+    while (static_cast<int>(placement.size()) < pages) {
+        for (int i = 0; i < count; ++i) {
+            int node = candidates[i];
+            while (taken[node] < share[node]) {
+                placement.push_back(nodeFrames[node][taken[node]++]);
+                if (numaPolicy == NumaPolicy::INTERLEAVE) break;
+            }
+        }
+    }
+
+    ProcessFrames &owned = processFrames[processId];
+    int virtualPage = 0;
+    for (int frame : placement) {
+        frameOwner[frame] = processId;
+        while (lookupFrame(makeKey(processId, virtualPage)) != -1) virtualPage++;
+        installPage(frame, processId, virtualPage++, accessCounter++, false);
+    }
+    for (int node = 0; node < nodeCount; ++node) {
+        for (size_t i = taken[node]; i < nodeFrames[node].size(); ++i) {
+            frameOwner[nodeFrames[node][i]] = processId;
+            owned.spare.push_back(nodeFrames[node][i]);
+            spareFrames++;
+        }
+    }
+    for (const FrameBlock &block : blocks) {
+        owned.blocks.push_back(block);
+        usedPages += 1 << block.order;
+    }
+
+    std::cout << "✅ Asignadas " << placement.size() << " páginas al proceso " << processId;
+    if (nodeCount > 1) {
+        std::cout << " | Por nodo:";
+        for (int node = 0; node < nodeCount; ++node) {
+            if (share[node] > 0) std::cout << " N" << node << "=" << share[node];
+        }
+    }
+    std::cout << "\n";
+    return static_cast<int>(placement.size()) == pages;
+}
+
+bool MemoryManager::allocate(int pages, int processId) {
+    return allocateFrames(pages, processId, false);
+}
+
+bool MemoryManager::allocateContiguous(int pages, int processId) {
+    return allocateFrames(pages, processId, true);
+}
+
+void MemoryManager::free(int pages, int processId) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    std::lock_guard<std::mutex> lock(replacementLock);
+    splitProcessHugePages(processId);
+    // Primero los mapeos compartidos: el marco sigue siendo de los otros procesos
+    int freed = unmapSharedPages(processId, pages);
+    for (int i = 0; i < totalPages && freed < pages; ++i) {
+        if (pageTable[i].processId == processId) {
+            dropPage(i);
+            freed++;
+        }
+    }
+
+    // Los bloques del proceso que quedaron vacíos vuelven al buddy
+    auto it = processFrames.find(processId);
+    if (it != processFrames.end()) {
+        ProcessFrames &owned = it->second;
+        std::vector<FrameBlock> kept;
+        for (const FrameBlock &block : owned.blocks) {
+            bool empty = true;
+            for (int frame = block.start; frame < block.start + (1 << block.order); ++frame) {
+                if (pageTable[frame].processId != -1) {
+                    empty = false;
+                    break;
+                }
+            }
+            if (empty) releaseBlock(block, processId);
+            else kept.push_back(block);
+        }
+        owned.blocks = kept;
+        size_t before = owned.spare.size();
+        owned.spare.erase(std::remove_if(owned.spare.begin(), owned.spare.end(),
+                                         [this](int frame) { return frameOwner[frame] == -1; }),
+                          owned.spare.end());
+        spareFrames -= static_cast<int>(before - owned.spare.size());
+    }
+    refreshExhausted();
+    std::cout << "🔄 Liberadas " << freed << " páginas del proceso " << processId << "\n";
+}
+
+void MemoryManager::freeProcessPages(int processId) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    std::lock_guard<std::mutex> lock(replacementLock);
+    splitProcessHugePages(processId);
+    int freed = unmapSharedPages(processId, totalPages);
+    for (int i = 0; i < totalPages; ++i) {
+        if (pageTable[i].processId == processId) {
+            dropPage(i);
+            freed++;
+        }
+    }
+
+    // Marcos sueltos del proceso que ahora usa otro tras un reemplazo o un fork:
+    // pasan a ser de ese proceso
+    for (int i = 0; i < totalPages; ++i) {
+        if (demandFrame[i] && frameOwner[i] == processId) {
+            if (pageTable[i].processId != -1) {
+                frameOwner[i] = pageTable[i].processId;
+                continue;
+            }
+            demandFrame[i] = 0;
+            frameOwner[i] = -1;
+            freeBlock(i, 0);
+            usedPages--;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> streamLock(readaheadLock);
+        streams.erase(processId);
+    }
+    homeNodes.erase(processId);
+
+    auto it = processFrames.find(processId);
+    if (it != processFrames.end()) {
+        for (const FrameBlock &block : it->second.blocks) {
+            releaseBlock(block, processId);
+        }
+        spareFrames -= static_cast<int>(it->second.spare.size());
+        processFrames.erase(it);
+    }
+    if (swap) {
+        std::lock_guard<std::mutex> swapLock(swapMutex);
+        swap->releaseProcess(processId);
+    }
+    refreshExhausted();
+    std::cout << "🗑️  Liberadas todas (" << freed << ") páginas del proceso " << processId << "\n";
+}
+
+// Candidata a víctima según la política (con replacementLock)
+int MemoryManager::findVictimPage() {
+    switch (replacementPolicy) {
+        case PageReplacement::FIFO:
+            return fifoList.head;
+            
+        case PageReplacement::LRU:
+            return popLruVictim();
+            
+        case PageReplacement::WORKING_SET:
+            return findWorkingSetVictim();
+
+        case PageReplacement::OPT:
+            // Sin conocer el futuro (acceso individual) se recurre a LRU
+            return optActive ? findOptimalVictim() : popLruVictim();
+    }
+    return -1;
+}
+
+// Víctima de Belady: el marco cuyo próximo uso está más lejos (montículo con borrado perezoso)
+int MemoryManager::findOptimalVictim() {
+    while (!optHeap.empty()) {
+        auto [nextUse, frame] = optHeap.top();
+        optHeap.pop();
+        if (pageTable[frame].processId != -1 && optNextUse[frame] == nextUse) {
+            return frame;
+        }
+    }
+    return popLruVictim();
+}
+
+// Las páginas fuera de la ventana ya salieron en trimWorkingSet: si aun así falta
+// un marco, el conjunto de trabajo no cabe y se expulsa la menos reciente (LRU)
+int MemoryManager::findWorkingSetVictim() {
+    return popLruVictim();
+}
+
+// Working Set: la página no se usó en las últimas workingSetWindow referencias
+bool MemoryManager::outsideWorkingSet(int frame, long long stamp) const {
+    return replacementPolicy == PageReplacement::WORKING_SET &&
+           pageTable[frame].lastUsed.load(std::memory_order_relaxed) < stamp - workingSetWindow;
+}
+
+// En cada fallo salen de memoria las páginas que dejaron la ventana, aunque haya
+// marcos libres: lo residente es el conjunto de trabajo. El orden LRU las da de la
+// más antigua a la más reciente, así cada página se recorre una vez
+// (con la franja de la página que falla tomada)
+void MemoryManager::trimWorkingSet(long long stamp, std::mutex* ownStripe) {
+    std::lock_guard<std::mutex> lock(replacementLock);
+    std::vector<int> busy;
+    while (true) {
+        int frame = popLruVictim();
+        if (frame == -1) break;
+        if (!outsideWorkingSet(frame, stamp)) {
+            requeueVictim(frame);
+            break;
+        }
+        if (tryEvictVictim(frame, ownStripe, nullptr)) releaseFrame(frame);
+        else busy.push_back(frame);   // En un fallo de otro CPU: se recorta más adelante
+    }
+    for (int frame : busy) requeueVictim(frame);
+}
+
+// Víctima LRU. Los hits sin lock solo actualizan lastUsed, así que el orden se
+// corrige aquí: lruList está ordenada por marca de carga y los marcos con hits
+// posteriores pasan a lruRefreshed con su marca real. La menor de las dos
+// cabezas es la página menos reciente (LRU exacto con un solo hilo) y una traza
+// con pocos hits solo hace operaciones O(1) sobre la lista
+int MemoryManager::popLruVictim() {
+    int refreshed = 0;
+    while (lruList.head != -1) {
+        int frame = lruList.head;
+        long long lastUsed = pageTable[frame].lastUsed.load(std::memory_order_relaxed);
+        if (lastUsed <= lruStamp[frame]) break;
+        lruList.remove(frame);
+        refreshLru(frame, lastUsed);
+    }
+    while (!lruRefreshed.empty()) {
+        auto [stamp, frame] = lruRefreshed.top();
+        if (lruStamp[frame] != stamp || lruList.prev[frame] != -2) {
+            lruRefreshed.pop();   // Entrada de una carga anterior
+            continue;
+        }
+        long long lastUsed = pageTable[frame].lastUsed.load(std::memory_order_relaxed);
+        if (lastUsed <= stamp || refreshed++ >= totalPages) break;
+        lruRefreshed.pop();
+        refreshLru(frame, lastUsed);
+    }
+
+    int listHead = lruList.head;
+    bool fromHeap = !lruRefreshed.empty() &&
+                    (listHead == -1 || lruRefreshed.top().first < lruStamp[listHead]);
+    int frame = fromHeap ? lruRefreshed.top().second : listHead;
+    if (frame == -1) return -1;
+    if (fromHeap) lruRefreshed.pop();
+    else lruList.remove(frame);
+    lruStamp[frame] = -1;
+    return frame;
+}
+
+void MemoryManager::refreshLru(int frame, long long stamp) {
+    lruStamp[frame] = stamp;
+    lruRefreshed.push({stamp, frame});
+    if (lruRefreshed.size() > static_cast<size_t>(totalPages) * 2 + 64) {
+        // Quitar las entradas obsoletas
+        std::vector<std::pair<long long, int>> entries;
+        for (int other = 0; other < totalPages; ++other) {
+            if (lruStamp[other] != -1 && lruList.prev[other] == -2) entries.push_back({lruStamp[other], other});
+        }
+        lruRefreshed = StampHeap(std::greater<std::pair<long long, int>>(), std::move(entries));
+    }
+}
+
+// Con FIFO no se mantiene el orden LRU: al cambiar de política todas las
+// páginas residentes entran en lruRefreshed con su última marca
+void MemoryManager::rebuildLruOrder() {
+    lruList.init(totalPages);
+    std::fill(lruStamp.begin(), lruStamp.end(), -1);
+    std::vector<std::pair<long long, int>> entries;
+    for (int frame = fifoList.head; frame != -1; frame = fifoList.next[frame]) {
+        lruStamp[frame] = pageTable[frame].lastUsed.load(std::memory_order_relaxed);
+        entries.push_back({lruStamp[frame], frame});
+    }
+    lruRefreshed = StampHeap(std::greater<std::pair<long long, int>>(), std::move(entries));
+}
+
+// La candidata no se pudo bloquear: vuelve a su estructura para probar otra
+void MemoryManager::requeueVictim(int frame) {
+    if (replacementPolicy == PageReplacement::FIFO) {
+        fifoList.moveToBack(frame);
+    } else if (replacementPolicy == PageReplacement::OPT && optActive) {
+        optHeap.push({optNextUse[frame], frame});
+    } else {
+        refreshLru(frame, pageTable[frame].lastUsed.load(std::memory_order_relaxed));
+    }
+}
+
+// Con BIND la víctima tiene que estar en el nodo del proceso: FIFO recorre la
+// lista y las demás políticas apartan en `skipped` las candidatas de otros nodos
+int MemoryManager::findVictimOnNode(int node, std::vector<int>& skipped) {
+    if (replacementPolicy == PageReplacement::FIFO) {
+        for (int frame = fifoList.head; frame != -1; frame = fifoList.next[frame]) {
+            if (frameNode[frame] == node) return frame;
+        }
+        return -1;
+    }
+    while (true) {
+        int frame = findVictimPage();
+        if (frame == -1 || frameNode[frame] == node) return frame;
+        skipped.push_back(frame);
+    }
+}
+
+// Expulsa la candidata si puede bloquear su franja (con replacementLock). Ya se
+// tiene la franja de la página que falla, así que la de la víctima se pide con try_lock
+bool MemoryManager::tryEvictVictim(int frame, std::mutex* ownStripe, FaultInfo* info) {
+    Page &page = pageTable[frame];
+    int victimProcess = page.processId;
+    int victimPage = page.pageId;
+    std::mutex &victimStripe = stripeFor(makeKey(victimProcess, victimPage));
+    bool sameStripe = &victimStripe == ownStripe;
+    if (!sameStripe && !victimStripe.try_lock()) return false;
+
+    // Un marco compartido sale de todos los procesos: hacen falta todas sus franjas
+    std::vector<uint64_t> sharers;
+    std::vector<std::mutex*> sharerStripes;
+    if (page.mapCount.load(std::memory_order_relaxed) > 1) {
+        sharers = frameSharers[frame];
+        for (uint64_t key : sharers) {
+            std::mutex *stripe = &stripeFor(key);
+            if (stripe == ownStripe || stripe == &victimStripe ||
+                std::find(sharerStripes.begin(), sharerStripes.end(), stripe) != sharerStripes.end()) {
+                continue;
+            }
+            if (!stripe->try_lock()) {
+                for (std::mutex *locked : sharerStripes) locked->unlock();
+                if (!sameStripe) victimStripe.unlock();
+                return false;
+            }
+            sharerStripes.push_back(stripe);
+        }
+    }
+
+    // Bajo presión la página enorme se divide y solo sale la subpágina víctima
+    if (pageTable[frame].huge.load(std::memory_order_relaxed)) {
+        splitHugePage(hugeStartOf(frame));
+    }
+    bool dirty = page.modified.load(std::memory_order_relaxed);
+    evictFrame(frame);
+    // Se encola antes de soltar la franja: un nuevo fallo de esa página ya ve su ranura
+    if (swap && dirty) {
+        if (sharers.empty()) scheduleWriteBack(victimProcess, victimPage);
+        for (uint64_t key : sharers) {
+            scheduleWriteBack(static_cast<int>(key >> 32), static_cast<int>(static_cast<uint32_t>(key)));
+        }
+    }
+    for (std::mutex *locked : sharerStripes) locked->unlock();
+    if (!sameStripe) victimStripe.unlock();
+
+    if (info) {
+        info->evictedProcess = victimProcess;
+        info->evictedPage = victimPage;
+        info->evictedDirty = dirty;
+    }
+    return true;
+}
+
+// Elige y expulsa una víctima (del nodo indicado, o de cualquiera si es -1); si
+// la franja de la candidata está ocupada se prueba otra
+int MemoryManager::claimVictim(std::mutex* ownStripe, FaultInfo* info, int node) {
+    std::lock_guard<std::mutex> lock(replacementLock);
+    if (node != -1) return claimVictimOnNode(ownStripe, info, node);
+    for (int attempt = 0; attempt <= totalPages + LOCK_STRIPES; ++attempt) {
+        int frame = findVictimPage();
+        if (frame == -1) return -1;
+        if (tryEvictVictim(frame, ownStripe, info)) return frame;
+        requeueVictim(frame);
+    }
+    return -1;
+}
+
+// Víctima del nodo (con replacementLock). Las candidatas apartadas vuelven a su
+// estructura al final; una con la franja ocupada también se aparta, porque otro CPU
+// puede estar esperando una víctima en nuestra franja y no debe repetirse siempre la misma
+int MemoryManager::claimVictimOnNode(std::mutex* ownStripe, FaultInfo* info, int node) {
+    std::vector<int> skipped;
+    int claimed = -1;
+    for (int attempt = 0; attempt <= totalPages + LOCK_STRIPES; ++attempt) {
+        int frame = findVictimOnNode(node, skipped);
+        if (frame == -1) break;
+        if (tryEvictVictim(frame, ownStripe, info)) {
+            claimed = frame;
+            break;
+        }
+        if (replacementPolicy == PageReplacement::FIFO) requeueVictim(frame);
+        else skipped.push_back(frame);
+    }
+    for (int frame : skipped) requeueVictim(frame);
+    return claimed;
+}
+
+// Marco libre o, si no hay, el de una víctima (con la franja de la página tomada)
+int MemoryManager::obtainFrame(int processId, int virtualPage, long long stamp, int cpu, std::mutex* ownStripe,
+                               FaultInfo* info) {
+    if (replacementPolicy == PageReplacement::WORKING_SET) trimWorkingSet(stamp, ownStripe);
+    int frame = takeFrame(processId, virtualPage, cpu);
+    // Como la recuperación por nodo: la víctima sale del nodo preferido y, salvo
+    // con BIND, de cualquier otro si allí no hay ninguna
+    int victimNode = -1;
+    if (frame == -1 && nodeCount > 1) {
+        int candidates[MAX_NODES];
+        nodeCandidates(processId, virtualPage, candidates);
+        victimNode = candidates[0];
+    }
+    for (int retry = 0; frame == -1; ++retry) {
+        frame = claimVictim(ownStripe, info, victimNode);
+        if (frame == -1 && victimNode != -1 && numaPolicy != NumaPolicy::BIND) {
+            frame = claimVictim(ownStripe, info, -1);
+        }
+        if (frame != -1) break;
+        if (residentPages.load() == 0 || retry == 100) return -1;
+        std::this_thread::yield();   // Todas las candidatas estaban en fallos de otros CPUs
+    }
+    return frame;
+}
+
+// Carga la página tras un fallo, con su franja tomada; devuelve el marco usado (-1 si no hay marcos)
+int MemoryManager::loadPage(int processId, int virtualPage, bool write, long long stamp, int cpu,
+                            std::mutex* ownStripe, FaultInfo* info, bool prefetch) {
+    int frame = obtainFrame(processId, virtualPage, stamp, cpu, ownStripe, info);
+    if (frame == -1) return -1;
+
+    // La página no se publica en el índice hasta que sus datos están en memoria
+    if (swap) {
+        int slot;
+        {
+            std::lock_guard<std::mutex> lock(swapMutex);
+            slot = swap->slotFor(makeKey(processId, virtualPage));
+        }
+        if (slot != -1) {
+            long long micros = pageInFromSwap(processId, virtualPage, slot);
+            if (info) info->pageInMicros = micros;
+        }
+    }
+    installPage(frame, processId, virtualPage, stamp, write, prefetch);
+    return frame;
+}
+
+// Primera escritura sobre un marco compartido: la página se copia a un marco propio
+// (con la franja de la página tomada). Si mientras se buscaba marco el compartido
+// quedó solo para este proceso se escribe en él, y si fue expulsado se carga como un fallo normal
+int MemoryManager::copyOnWrite(int processId, int virtualPage, int shared, long long stamp, int cpu,
+                               std::mutex* ownStripe, FaultInfo* info) {
+    int frame = obtainFrame(processId, virtualPage, stamp, cpu, ownStripe, info);
+    if (frame == -1) return -1;
+    uint64_t key = makeKey(processId, virtualPage);
+    std::unique_lock<std::mutex> lock(replacementLock);
+    int current = lookupFrame(key);
+    if (current == -1) {
+        releaseFrame(frame);
+        lock.unlock();
+        return loadPage(processId, virtualPage, true, stamp, cpu, ownStripe, info);
+    }
+    if (pageTable[current].mapCount.load(std::memory_order_relaxed) == 1) {
+        releaseFrame(frame);
+        return current;
+    }
+    unmapKey(current, key);
+    mapPage(frame, processId, virtualPage, stamp, true, false);
+    cowFaults++;
+    if (info) info->copiedFrom = shared;
+    return frame;
+}
+
+// Hit de lectura sin locks: índice con seqlock y marca de uso atómica. Una página
+// fuera del conjunto de trabajo no es un hit: la resuelve touchPage
+inline int MemoryManager::readHit(const PageRef& ref, long long stamp) {
+    if (ref.write) return -1;
+    int frame = lookupFrame(makeKey(ref.processId, ref.virtualPage));
+    if (frame == -1 || outsideWorkingSet(frame, stamp)) return -1;
+    pageTable[frame].lastUsed.store(stamp, std::memory_order_relaxed);
+    return frame;
+}
+
+// Cuenta el acceso en counts[2 * nodo + remoto]; el nodo de origen del último
+// proceso se recuerda porque los lotes suelen repetir proceso
+inline void MemoryManager::countNodeAccess(int processId, int frame, long long* counts, int& lastProcess,
+                                           int& lastHome) const {
+    if (processId != lastProcess) {
+        lastProcess = processId;
+        lastHome = homeNodeOf(processId);
+    }
+    int node = frameNode[frame];
+    counts[2 * node + (node != lastHome ? 1 : 0)]++;
+}
+
+void MemoryManager::addNodeAccesses(const long long* counts) {
+    for (int node = 0; node < nodeCount; ++node) {
+        if (counts[2 * node] > 0) nodes[node]->localAccesses += counts[2 * node];
+        if (counts[2 * node + 1] > 0) nodes[node]->remoteAccesses += counts[2 * node + 1];
+    }
+}
+
+// Escrituras y fallos: se toma la franja de la página
+int MemoryManager::touchPage(const PageRef& ref, long long stamp, int cpu, bool& hit, FaultInfo* info) {
+    uint64_t key = makeKey(ref.processId, ref.virtualPage);
+    std::mutex &stripe = stripeFor(key);
+    std::lock_guard<std::mutex> lock(stripe);
+    int frame = lookupFrame(key);   // Otro CPU pudo cargarla mientras tanto
+    if (frame != -1 && outsideWorkingSet(frame, stamp)) {
+        // Dejó el conjunto de trabajo: con Working Set ya no estaría en memoria, así
+        // que sale y la referencia es un fallo (si está compartida y otra franja está
+        // ocupada, cuenta como hit)
+        std::lock_guard<std::mutex> replacement(replacementLock);
+        if (tryEvictVictim(frame, &stripe, nullptr)) {
+            releaseFrame(frame);
+            frame = -1;
+        }
+    }
+    if (frame != -1 && ref.write && pageTable[frame].mapCount.load(std::memory_order_relaxed) > 1) {
+        int copy = copyOnWrite(ref.processId, ref.virtualPage, frame, stamp, cpu, &stripe, info);
+        if (copy != frame) {
+            hit = false;
+            return copy;
+        }
     }
+    if (frame != -1) {
+        pageTable[frame].lastUsed.store(stamp, std::memory_order_relaxed);
+        if (ref.write) pageTable[frame].modified.store(true, std::memory_order_relaxed);
+        hit = true;
+        return frame;
+    }
+    hit = false;
+    return loadPage(ref.processId, ref.virtualPage, ref.write, stamp, cpu, &stripe, info);
+}
+
+void MemoryManager::accessPage(int processId, int virtualPage, bool write) {
+    yieldToExclusive();
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    FaultInfo info;
+    bool hit = false;
+    long long stamp = accessCounter.fetch_add(1, std::memory_order_relaxed);
+    PageRef ref{processId, virtualPage, write};
+    int slot = cpuSlot(-1);
+    int frame = readHit(ref, stamp);
+    if (frame != -1) hit = true;
+    else frame = touchPage(ref, stamp, slot, hit, &info);
+    if (tlbEnabled && frame != -1 && tlbAccess(tlbs[slot], makeKey(processId, virtualPage), frame)) tlbMisses++;
+    if (nodeCount > 1 && frame != -1) {
+        long long counts[2 * MAX_NODES] = {};
+        int lastProcess = -1;
+        int home = 0;
+        countNodeAccess(processId, frame, counts, lastProcess, home);
+        addNodeAccesses(counts);
+        if (frameNode[frame] != home) {
+            std::cout << "🧭 Acceso remoto: marco " << frame << " en el nodo " << frameNode[frame]
+                      << ", proceso del nodo " << home << "\n";
+        }
+    }
+    if (hit) {
+        long long hits = ++pageHits;
+        std::cout << "✅ HIT - Página " << virtualPage << " del proceso " << processId 
+                  << " en marco " << frame << " | Hits: " << hits << " | Faults: " << pageFaults.load() << "\n";
+        if (readaheadEnabled && pageTable[frame].prefetched.exchange(false, std::memory_order_relaxed)) {
+            std::cout << "📚 La página había sido precargada por readahead\n";
+            int prefetched = readaheadOnHit(processId, virtualPage, stamp, slot);
+            if (prefetched > 0) std::cout << "📚 Readahead: " << prefetched << " páginas más precargadas\n";
+        }
+        return;
+    }
+    
+    // Page fault - la página ya se cargó en un marco libre o en el de una víctima
+    long long faults = ++pageFaults;
+    std::cout << "❌ PAGE FAULT - Página " << virtualPage << " del proceso " << processId 
+              << " | Hits: " << pageHits.load() << " | Faults: " << faults << "\n";
+    if (frame != -1 && info.evictedProcess != -1) {
+        std::cout << "🔁 Reemplazando página en marco " << frame 
+                  << " (Proceso " << info.evictedProcess 
+                  << ", Página " << info.evictedPage << ")\n";
+        if (swap && info.evictedDirty) {
+            std::cout << "📝 Página sucia enviada al swap (escritura asíncrona)\n";
+        }
+    }
+    if (frame != -1 && info.copiedFrom != -1) {
+        std::cout << "🍴 Copia al escribir: la página compartida del marco " << info.copiedFrom
+                  << " se copió al marco " << frame << "\n";
+    }
+    if (frame != -1 && info.pageInMicros >= 0) {
+        std::cout << "💾 Página recuperada del swap en " << info.pageInMicros << " µs\n";
+    }
+    if (readaheadEnabled && frame != -1) {
+        int prefetched = readaheadOnFault(processId, virtualPage, stamp, slot);
+        if (prefetched > 0) std::cout << "📚 Readahead: acceso secuencial detectado, " << prefetched << " páginas precargadas\n";
+    }
+}
+
+AccessResult MemoryManager::accessPages(const PageRef* refs, size_t count, std::vector<uint64_t>* outcomeBitmap,
+                                        int cpu) {
+    AccessResult result{0, 0};
+    uint64_t* bits = nullptr;
+    if (outcomeBitmap) {
+        outcomeBitmap->assign((count + 63) / 64, 0);
+        bits = outcomeBitmap->data();
+    }
+
+    yieldToExclusive();
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    if (replacementPolicy == PageReplacement::OPT) {
+        // OPT decide con todo el lote: se ejecuta con la tabla en exclusiva
+        table.unlock();
+        std::unique_lock<std::shared_mutex> exclusive(tableLock);
+        return accessPagesOptimal(refs, count, bits);
+    }
+
+    int slot = cpuSlot(cpu);
+    CpuTlb &tlb = tlbs[slot];
+    bool modelTlb = tlbEnabled;
+    bool readahead = readaheadEnabled;
+    bool numa = nodeCount > 1;
+    bool plainHits = !modelTlb && !readahead && !numa;
+    long long misses = 0;
+    long long nodeAccesses[2 * MAX_NODES] = {};
+    int lastProcess = -1;
+    int lastHome = 0;
+    // Una sola operación atómica reserva las marcas de tiempo de todo el lote
+    long long stamp = accessCounter.fetch_add(static_cast<long long>(count), std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        long long now = stamp + static_cast<long long>(i);
+        int frame = readHit(refs[i], now);
+        if (frame != -1 && plainHits) {
+            // Camino corto: sin TLB, readahead ni NUMA un hit no necesita nada más
+            result.hits++;
+            if (bits) bits[i >> 6] |= 1ULL << (i & 63);
+            continue;
+        }
+        bool hit = frame != -1;
+        if (!hit) frame = touchPage(refs[i], now, slot, hit, nullptr);
+        if (modelTlb && frame != -1 && tlbAccess(tlb, makeKey(refs[i].processId, refs[i].virtualPage), frame)) {
+            misses++;
+        }
+        if (numa && frame != -1) countNodeAccess(refs[i].processId, frame, nodeAccesses, lastProcess, lastHome);
+        if (hit) {
+            result.hits++;
+            if (bits) bits[i >> 6] |= 1ULL << (i & 63);
+        } else {
+            result.faults++;
+        }
+        if (readahead && frame != -1) {
+            if (!hit) {
+                readaheadOnFault(refs[i].processId, refs[i].virtualPage, now, slot);
+            } else if (pageTable[frame].prefetched.load(std::memory_order_relaxed) &&
+                       pageTable[frame].prefetched.exchange(false, std::memory_order_relaxed)) {
+                readaheadOnHit(refs[i].processId, refs[i].virtualPage, now, slot);
+            }
+        }
+    }
+
+    pageHits += result.hits;
+    pageFaults += result.faults;
+    tlbMisses += misses;
+    if (numa) addNodeAccesses(nodeAccesses);
+    return result;
+}
+
+AccessResult MemoryManager::accessPages(const std::vector<PageRef>& refs, std::vector<uint64_t>* outcomeBitmap,
+                                        int cpu) {
+    return accessPages(refs.data(), refs.size(), outcomeBitmap, cpu);
+}
+
+// OPT fuera de línea: índice de próximo uso construido con una pasada hacia atrás
+// (tabla en exclusiva)
+AccessResult MemoryManager::accessPagesOptimal(const PageRef* refs, size_t count, uint64_t* bits) {
+    AccessResult result{0, 0};
+    std::vector<long long> nextUse(count);
+    std::unordered_map<uint64_t, long long> upcoming;
+    upcoming.reserve(count / 4 + 16);
+    for (size_t i = count; i-- > 0;) {
+        auto [it, inserted] = upcoming.try_emplace(makeKey(refs[i].processId, refs[i].virtualPage), 0);
+        nextUse[i] = inserted ? NEVER_USED : it->second;
+        it->second = static_cast<long long>(i);
+    }
+
+    // Páginas ya residentes: su próximo uso es su primera aparición en el lote
+    optHeap = std::priority_queue<std::pair<long long, int>>();
+    optActive = true;
+    for (int frame = 0; frame < totalPages; ++frame) {
+        const Page &page = pageTable[frame];
+        if (page.processId == -1) continue;
+        auto it = upcoming.find(makeKey(page.processId, page.pageId));
+        optNextUse[frame] = (it != upcoming.end()) ? it->second : NEVER_USED;
+        optHeap.push({optNextUse[frame], frame});
+    }
+
+    int slot = cpuSlot(-1);
+    long long misses = 0;
+    long long nodeAccesses[2 * MAX_NODES] = {};
+    int lastProcess = -1;
+    int lastHome = 0;
+    long long stamp = accessCounter.fetch_add(static_cast<long long>(count), std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        long long now = stamp + static_cast<long long>(i);
+        bool hit = false;
+        int frame = readHit(refs[i], now);
+        if (frame != -1) hit = true;
+        else frame = touchPage(refs[i], now, slot, hit, nullptr);
+        if (tlbEnabled && frame != -1 && tlbAccess(tlbs[slot], makeKey(refs[i].processId, refs[i].virtualPage), frame)) {
+            misses++;
+        }
+        if (nodeCount > 1 && frame != -1) countNodeAccess(refs[i].processId, frame, nodeAccesses, lastProcess, lastHome);
+        if (hit) {
+            result.hits++;
+            if (bits) bits[i >> 6] |= 1ULL << (i & 63);
+        } else {
+            result.faults++;
+            if (frame == -1) continue;
+        }
+        optNextUse[frame] = nextUse[i];
+        optHeap.push({nextUse[i], frame});
+    }
+
+    optActive = false;
+    optHeap = std::priority_queue<std::pair<long long, int>>();
+    pageHits += result.hits;
+    pageFaults += result.faults;
+    tlbMisses += misses;
+    if (nodeCount > 1) addNodeAccesses(nodeAccesses);
+    return result;
+}
+
+// ---------------- Swap ----------------
+
+bool MemoryManager::enableSwap(DeviceManager* device, const std::string& path, int latencyMs) {
+    disableSwap();
+    auto space = std::make_unique<SwapSpace>(path);
+    if (!space->isOpen()) {
+        std::cout << "❌ No se pudo crear el archivo de swap '" << path << "'\n";
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    swap = std::move(space);
+    swapDevice = device;
+    swapLatencyMs = latencyMs;
+    std::cout << "💾 Swap activado en '" << path << "' (latencia modelada: " << latencyMs << " ms)\n";
+    return true;
+}
+
+void MemoryManager::disableSwap() {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    waitForSwapIO();
+    swap.reset();
+    swapDevice = nullptr;
+}
+
+bool MemoryManager::isSwapEnabled() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return swap != nullptr;
+}
+
+std::string MemoryManager::getSwapPath() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return swap ? swap->getPath() : std::string();
+}
+
+void MemoryManager::finishSwapIO() {
+    std::lock_guard<std::mutex> lock(swapMutex);
+    pendingSwapIO--;
+    swapDrained.notify_all();
+}
+
+void MemoryManager::waitForSwapIO() {
+    std::unique_lock<std::mutex> lock(swapMutex);
+    swapDrained.wait(lock, [this]() { return pendingSwapIO == 0; });
+}
+
+// Escritura diferida: no se espera a que el disco termine
+void MemoryManager::scheduleWriteBack(int processId, int virtualPage) {
+    int slot;
+    {
+        std::lock_guard<std::mutex> lock(swapMutex);
+        slot = swap->assignSlot(makeKey(processId, virtualPage));
+        pendingSwapIO++;
+    }
+
+    IORequest request{processId, DeviceType::DISK_DRIVE, "swap-out", 0, swapLatencyMs};
+    request.transfer = [this, slot, processId, virtualPage]() {
+        auto start = std::chrono::steady_clock::now();
+        if (!swap->writeSlot(slot, processId, virtualPage)) swapErrors++;
+        writeBackNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        writeBacks++;
+    };
+    request.completion = InterruptType::SWAP_OUT;   // No debe despertar al proceso dueño
+    request.completionData = virtualPage;
+    request.onComplete = [this]() { finishSwapIO(); };
+    swapDevice->submitIO(request);
+}
+
+// Lectura desde el swap: el fallo espera la interrupción PAGE_FAULT del disco.
+// Devuelve la espera en µs
+long long MemoryManager::pageInFromSwap(int processId, int virtualPage, int slot) {
+    auto start = std::chrono::steady_clock::now();
+    auto done = std::make_shared<std::promise<void>>();
+    std::future<void> ready = done->get_future();
+    {
+        std::lock_guard<std::mutex> lock(swapMutex);
+        pendingSwapIO++;
+    }
+
+    IORequest request{processId, DeviceType::DISK_DRIVE, "swap-in", 0, swapLatencyMs};
+    request.transfer = [this, slot, processId, virtualPage]() {
+        if (!swap->readSlot(slot, processId, virtualPage)) swapErrors++;
+    };
+    request.completion = InterruptType::PAGE_FAULT;
+    request.completionData = virtualPage;
+    request.onComplete = [this, done]() {
+        done->set_value();
+        finishSwapIO();
+    };
+    swapDevice->submitIO(request);
+    ready.wait();
+
+    long long nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    pageInNanos += nanos;
+    pageIns++;
+    return nanos / 1000;
+}
+
+// ---------------- Readahead ----------------
+
+void MemoryManager::setReadahead(bool enabled) {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    readaheadEnabled = enabled;
+    if (!enabled) {
+        std::lock_guard<std::mutex> lock(readaheadLock);
+        streams.clear();
+    }
+    std::cout << (enabled ? "📚 Readahead activado" : "📚 Readahead desactivado") << "\n";
+}
+
+bool MemoryManager::isReadaheadEnabled() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return readaheadEnabled;
+}
+
+// Fallo de demanda: dos saltos iguales seguidos confirman el flujo y se precarga la
+// ventana desde la página siguiente. Devuelve las páginas precargadas
+int MemoryManager::readaheadOnFault(int processId, int virtualPage, long long stamp, int cpu) {
+    int first, stride, count;
+    {
+        std::lock_guard<std::mutex> lock(readaheadLock);
+        ReadaheadStream &stream = streams[processId];
+        int step = stream.lastPage == -1 ? 0 : virtualPage - stream.lastPage;
+        bool confirmed = step != 0 && std::abs(step) <= READAHEAD_MAX_STRIDE && step == stream.stride;
+        stream.stride = step;
+        stream.lastPage = virtualPage;
+        if (!confirmed) {
+            stream.active = false;
+            return 0;
+        }
+        // La ventana se conserva entre flujos del proceso: es lo aprendido
+        if (stream.window == 0) stream.window = READAHEAD_INITIAL;
+        stream.active = true;
+        first = virtualPage + step;
+        stride = step;
+        count = stream.window;
+        stream.nextPage = first + stride * count;
+    }
+    return prefetchPages(processId, first, stride, count, stamp, cpu);
+}
+
+// Primer hit sobre una página precargada: cuando quedan por delante menos de media
+// ventana se lanza la ronda siguiente con el doble de páginas
+int MemoryManager::readaheadOnHit(int processId, int virtualPage, long long stamp, int cpu) {
+    prefetchesUseful++;
+    int first, stride, count;
+    {
+        std::lock_guard<std::mutex> lock(readaheadLock);
+        auto it = streams.find(processId);
+        if (it == streams.end() || !it->second.active) return 0;
+        ReadaheadStream &stream = it->second;
+        int distance = stream.nextPage - virtualPage;
+        if (distance % stream.stride != 0 || distance / stream.stride <= 0) return 0;
+        stream.lastPage = virtualPage;
+        if (distance / stream.stride > (stream.window + 1) / 2) return 0;
+        stream.window = std::min(stream.window * 2, READAHEAD_MAX);
+        first = stream.nextPage;
+        stride = stream.stride;
+        count = stream.window;
+        stream.nextPage = first + stride * count;
+    }
+    return prefetchPages(processId, first, stride, count, stamp, cpu);
+}
+
+// Carga las páginas del flujo que no estén residentes, cada una con su franja.
+// Una ronda no ocupa más de un cuarto de la memoria
+int MemoryManager::prefetchPages(int processId, int firstPage, int stride, int count, long long stamp, int cpu) {
+    count = std::min(count, std::max(1, totalPages / 4));
+    int loaded = 0;
+    for (int i = 0; i < count; ++i) {
+        long long page = firstPage + static_cast<long long>(stride) * i;
+        if (page < 0 || page > INT32_MAX) break;
+        uint64_t key = makeKey(processId, static_cast<int>(page));
+        std::mutex &stripe = stripeFor(key);
+        std::lock_guard<std::mutex> lock(stripe);
+        if (lookupFrame(key) != -1) continue;
+        if (loadPage(processId, static_cast<int>(page), false, stamp, cpu, &stripe, nullptr, true) == -1) break;
+        loaded++;
+    }
+    prefetchesIssued += loaded;
+    return loaded;
+}
+
+// Precarga expulsada sin usarse. Si era del tramo pendiente del flujo actual la
+// ventana era demasiado grande y se reduce a la mitad; las sobrantes de un flujo
+// anterior (por ejemplo, pasado el final de un recorrido) solo se cuentan
+void MemoryManager::prefetchWasted(int processId, int virtualPage) {
+    prefetchesWasted++;
+    std::lock_guard<std::mutex> lock(readaheadLock);
+    auto it = streams.find(processId);
+    if (it == streams.end() || !it->second.active) return;
+    ReadaheadStream &stream = it->second;
+    bool pending = (virtualPage - stream.lastPage) / stream.stride > 0 &&
+                   (stream.nextPage - virtualPage) / stream.stride > 0;
+    if (pending) stream.window = std::max(1, stream.window / 2);
+}
+
+// ---------------- Páginas enormes ----------------
+
+// Tamaño legible en KiB o MiB
+static std::string formatSize(long long bytes) {
+    if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0) return std::to_string(bytes / (1024 * 1024)) + " MiB";
+    return std::to_string(bytes / 1024) + " KiB";
+}
+
+static const char* numaPolicyName(NumaPolicy policy) {
+    switch (policy) {
+        case NumaPolicy::LOCAL_FIRST: return "local primero";
+        case NumaPolicy::INTERLEAVE: return "intercalada";
+        case NumaPolicy::BIND: return "ligada al nodo";
+    }
+    return "";
+}
+
+bool MemoryManager::enableHugePages(int order, int thresholdPercent, int scanIntervalMs) {
+    stopHugePageDaemon();
+    {
+        std::unique_lock<std::shared_mutex> table(tableLock);
+        if (order < 1 || order > 20) {
+            std::cout << "❌ Orden de página enorme inválido (1-20)\n";
+            return false;
+        }
+        if (hugePageOrder != order) {
+            // Las páginas enormes del tamaño anterior vuelven a ser páginas base
+            std::lock_guard<std::mutex> lock(replacementLock);
+            for (int start = 0; hugePageOrder > 0 && start < totalPages; ++start) {
+                if (pageTable[start].huge.load(std::memory_order_relaxed) && hugeStartOf(start) == start) {
+                    splitHugePage(start);
+                }
+            }
+        }
+        hugePageOrder = order;
+        tlbEnabled = true;
+        hugePageThreshold = std::min(100, std::max(1, thresholdPercent));
+        std::cout << "🧱 Páginas enormes activadas: " << formatSize(static_cast<long long>(SwapSpace::PAGE_SIZE) << order)
+                  << " (" << (1 << order) << " marcos) | Umbral de promoción: " << hugePageThreshold << "%";
+        if (scanIntervalMs > 0) std::cout << " | Pasada cada " << scanIntervalMs << " ms";
+        std::cout << "\n";
+        int maxOrder = 0;
+        for (const auto &node : nodes) maxOrder = std::max(maxOrder, node->buddy.getMaxOrder());
+        if (order > maxOrder) {
+            std::cout << "⚠️  No cabe ninguna en " << totalPages
+                      << " marcos: solo tendrán efecto en trazas con más marcos\n";
+        }
+    }
+
+    if (scanIntervalMs > 0) {
+        hugePageDaemon = std::thread([this, scanIntervalMs]() {
+            std::unique_lock<std::mutex> lock(daemonMutex);
+            while (!daemonWake.wait_for(lock, std::chrono::milliseconds(scanIntervalMs),
+                                        [this]() { return daemonStop; })) {
+                lock.unlock();
+                promoteHugePages();
+                lock.lock();
+            }
+        });
+    }
+    return true;
+}
+
+void MemoryManager::disableHugePages() {
+    stopHugePageDaemon();
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    std::lock_guard<std::mutex> lock(replacementLock);
+    for (int start = 0; hugePageOrder > 0 && start < totalPages; ++start) {
+        if (pageTable[start].huge.load(std::memory_order_relaxed) && hugeStartOf(start) == start) {
+            splitHugePage(start);
+        }
+    }
+    hugePageOrder = 0;
+}
+
+void MemoryManager::stopHugePageDaemon() {
+    {
+        std::lock_guard<std::mutex> lock(daemonMutex);
+        daemonStop = true;
+    }
+    daemonWake.notify_all();
+    if (hugePageDaemon.joinable()) hugePageDaemon.join();
+    std::lock_guard<std::mutex> lock(daemonMutex);
+    daemonStop = false;
+}
+
+int MemoryManager::promoteHugePages() {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    return collapseHugePages();
+}
+
+int MemoryManager::getHugePageOrder() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return hugePageOrder;
 }
 
-bool MemoryManager::allocate(int pages, int processId) {
-    if (usedPages + pages > totalPages) {
-        std::cout << "Memoria insuficiente. Necesario liberar " << (usedPages + pages - totalPages) << " páginas.\n";
+int MemoryManager::getHugePageThreshold() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return hugePageThreshold;
+}
+
+void MemoryManager::enableTlbModel() {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    tlbEnabled = true;
+}
+
+long long MemoryManager::getTlbMisses() const {
+    return tlbMisses.load();
+}
+
+// ---------------- Copy-on-write ----------------
+
+// El hijo hereda las páginas residentes del padre sin copiarlas: mapea los mismos
+// marcos y cada página se copia en su primera escritura (copyOnWrite). Las páginas
+// del padre que están en el swap no se heredan
+bool MemoryManager::fork(int parentPid, int childPid) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    if (parentPid == childPid) {
+        std::cout << "❌ El proceso hijo debe tener un ID distinto al del padre\n";
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(replacementLock);
+    auto usesMemory = [this](int processId) {
+        if (processFrames.count(processId)) return true;
+        for (const Page &page : pageTable) {
+            if (page.processId == processId) return true;
+        }
+        for (const auto &entry : frameSharers) {
+            for (uint64_t key : entry.second) {
+                if (static_cast<int>(key >> 32) == processId) return true;
+            }
+        }
+        return false;
+    };
+    if (usesMemory(childPid)) {
+        std::cout << "❌ El proceso " << childPid << " ya tiene memoria asignada\n";
+        return false;
+    }
+    if (!usesMemory(parentPid)) {
+        std::cout << "❌ El proceso " << parentPid << " no tiene memoria asignada\n";
         return false;
     }
 
-    int allocated = 0;
-    for (int i = 0; i < totalPages && allocated < pages; ++i) {
-        if (pageTable[i].processId == -1) {
-            pageTable[i].processId = processId;
-            pageTable[i].pageId = allocated;
-            pageTable[i].referenced = true;
-            pageTable[i].modified = false;
-            pageTable[i].lastUsed = accessCounter++;
-            pageTable[i].accessHistory.push_back(accessCounter);
-            
-            fifoQueue.push(i);
-            pageUsage[i] = accessCounter;
-            allocated++;
-            usedPages++;
+    // Un marco compartido nunca es parte de una página enorme
+    splitProcessHugePages(parentPid);
+    std::vector<std::pair<int, int>> mappings;   // (marco, página virtual)
+    for (int frame = 0; frame < totalPages; ++frame) {
+        const Page &page = pageTable[frame];
+        if (page.processId == -1) continue;
+        if (page.mapCount.load(std::memory_order_relaxed) == 1) {
+            if (page.processId == parentPid) mappings.push_back({frame, page.pageId});
+            continue;
+        }
+        for (uint64_t key : frameSharers[frame]) {
+            if (static_cast<int>(key >> 32) == parentPid) {
+                mappings.push_back({frame, static_cast<int>(static_cast<uint32_t>(key))});
+            }
         }
     }
 
-    std::cout << "✅ Asignadas " << allocated << " páginas al proceso " << processId << "\n";
-    return allocated == pages;
+    pageIndex.reserve(pageIndex.size() + mappings.size());
+    for (const auto &[frame, virtualPage] : mappings) {
+        Page &page = pageTable[frame];
+        std::vector<uint64_t> &keys = frameSharers[frame];
+        if (keys.empty()) keys.push_back(makeKey(page.processId, page.pageId));
+        keys.push_back(makeKey(childPid, virtualPage));
+        indexInsert(makeKey(childPid, virtualPage), frame);
+        page.mapCount++;
+    }
+    sharedMappings += static_cast<long long>(mappings.size());
+    forkedPages += static_cast<long long>(mappings.size());
+    if (nodeCount > 1) homeNodes[childPid] = homeNodeOf(parentPid);
+    std::cout << "🍴 Fork: el proceso " << childPid << " comparte " << mappings.size()
+              << " páginas del proceso " << parentPid << " (copy-on-write)\n";
+    return true;
 }
 
-void MemoryManager::free(int pages, int processId) {
-    int freed = 0;
-    for (int i = 0; i < totalPages && freed < pages; ++i) {
-        if (pageTable[i].processId == processId) {
-            pageTable[i].processId = -1;
-            pageTable[i].pageId = -1;
-            pageTable[i].referenced = false;
-            freed++;
-            usedPages--;
+long long MemoryManager::getCowFaults() const {
+    return cowFaults.load();
+}
+
+long long MemoryManager::getSharedPages() const {
+    return sharedMappings.load();
+}
+
+// ---------------- Instantánea ----------------
+
+// Página de la tabla sin atómicos, para copiarla en bloque
+struct PageRecord {
+    int pageId;
+    int processId;
+    long long lastUsed;
+    int mapCount;
+    uint8_t referenced;
+    uint8_t modified;
+    uint8_t huge;
+    uint8_t prefetched;
+};
+
+struct MemoryCounters {
+    long long usedPages, residentPages, spareFrames, accessCounter, pageFaults, pageHits;
+    long long sharedMappings, forkedPages, cowFaults, hugePages, hugePromotions, hugeSplits, tlbMisses;
+    long long prefetchesIssued, prefetchesUseful, prefetchesWasted;
+    long long pageIns, pageInNanos, writeBacks, writeBackNanos, swapErrors;
+};
+
+static const size_t PAGE_RECORD_CHUNK = 4096;
+
+void MemoryManager::saveState(SnapshotWriter& out) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    std::lock_guard<std::mutex> lock(replacementLock);
+    drainFrameCaches();   // Los marcos de las cachés por CPU vuelven a su buddy
+
+    out.put(totalPages);
+    out.put(nodeCount);
+    out.put(numaPolicy);
+    out.put(replacementPolicy);
+    out.put(workingSetWindow);
+    out.put(readaheadEnabled);
+    out.put(hugePageOrder);
+    out.put(hugePageThreshold);
+    out.put(tlbEnabled);
+    MemoryCounters counters{usedPages, residentPages, spareFrames, accessCounter, pageFaults, pageHits,
+                            sharedMappings, forkedPages, cowFaults, hugePages, hugePromotions, hugeSplits,
+                            tlbMisses, prefetchesIssued, prefetchesUseful, prefetchesWasted,
+                            pageIns, pageInNanos, writeBacks, writeBackNanos, swapErrors};
+    out.put(counters);
+    for (const auto &node : nodes) {
+        out.put(node->firstFrame);
+        out.put(node->frames);
+        out.put(node->localLatencyNs);
+        out.put(node->remoteLatencyNs);
+        out.put(node->localAccesses.load());
+        out.put(node->remoteAccesses.load());
+        node->buddy.saveState(out);
+    }
+
+    out.put<uint64_t>(pageTable.size());
+    std::vector<PageRecord> chunk;
+    for (size_t first = 0; first < pageTable.size(); first += PAGE_RECORD_CHUNK) {
+        chunk.resize(std::min(PAGE_RECORD_CHUNK, pageTable.size() - first));
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            const Page &page = pageTable[first + i];
+            chunk[i] = PageRecord{page.pageId, page.processId, page.lastUsed.load(std::memory_order_relaxed),
+                                  page.mapCount.load(std::memory_order_relaxed), page.referenced,
+                                  page.modified.load(std::memory_order_relaxed),
+                                  page.huge.load(std::memory_order_relaxed),
+                                  page.prefetched.load(std::memory_order_relaxed)};
         }
+        out.putRaw(chunk.data(), chunk.size());
+    }
+    out.putVector(frameOwner);
+    out.putVector(demandFrame);
+    out.putVector(hugeStamp);
+    out.putVector(fifoList.prev);
+    out.putVector(fifoList.next);
+    out.put(fifoList.head);
+    out.put(fifoList.tail);
+
+    out.put<uint64_t>(processFrames.size());
+    for (const auto &[processId, owned] : processFrames) {
+        out.put(processId);
+        out.putVector(owned.blocks);
+        out.putVector(owned.spare);
+    }
+    out.put<uint64_t>(frameSharers.size());
+    for (const auto &[frame, keys] : frameSharers) {
+        out.put(frame);
+        out.putVector(keys);
+    }
+    out.put<uint64_t>(homeNodes.size());
+    for (const auto &[processId, node] : homeNodes) {
+        out.put(processId);
+        out.put(node);
     }
-    std::cout << "🔄 Liberadas " << freed << " páginas del proceso " << processId << "\n";
 }
 
-void MemoryManager::freeProcessPages(int processId) {
-    int freed = 0;
-    for (int i = 0; i < totalPages; ++i) {
-        if (pageTable[i].processId == processId) {
-            pageTable[i].processId = -1;
-            pageTable[i].pageId = -1;
-            pageTable[i].referenced = false;
-            freed++;
-            usedPages--;
+// Se lee todo a variables locales y, si la sección es válida, commit reemplaza el
+// estado. El índice, el orden LRU, las cachés y los TLB se reconstruyen
+bool MemoryManager::loadState(SnapshotReader& in, std::function<void()>& commit) {
+    int total, count, window, hugeOrder, hugeThreshold;
+    NumaPolicy numa;
+    PageReplacement policy;
+    bool readahead, tlb;
+    MemoryCounters counters;
+    if (!in.get(total) || !in.get(count) || !in.get(numa) || !in.get(policy) || !in.get(window) ||
+        !in.get(readahead) || !in.get(hugeOrder) || !in.get(hugeThreshold) || !in.get(tlb) || !in.get(counters)) {
+        return false;
+    }
+    if (total <= 0 || count < 1 || count > std::min(MAX_NODES, total) || static_cast<int>(numa) < 0 ||
+        static_cast<int>(numa) > 2 || static_cast<int>(policy) < 0 || static_cast<int>(policy) > 3 ||
+        hugeOrder < 0 || hugeOrder > 20) {
+        return in.fail();
+    }
+    auto validFrame = [total](int frame) { return frame >= 0 && frame < total; };
+
+    std::vector<std::unique_ptr<MemoryNode>> loadedNodes;
+    int first = 0;
+    for (int node = 0; node < count; ++node) {
+        auto memory = std::make_unique<MemoryNode>();
+        long long local, remote;
+        if (!in.get(memory->firstFrame) || !in.get(memory->frames) || !in.get(memory->localLatencyNs) ||
+            !in.get(memory->remoteLatencyNs) || !in.get(local) || !in.get(remote)) {
+            return false;
+        }
+        if (memory->firstFrame != first || memory->frames <= 0 || memory->frames > total - first ||
+            !memory->buddy.loadState(in, memory->frames)) {
+            return in.fail();
         }
+        memory->localAccesses = local;
+        memory->remoteAccesses = remote;
+        first += memory->frames;
+        loadedNodes.push_back(std::move(memory));
     }
-    std::cout << "🗑️  Liberadas todas (" << freed << ") páginas del proceso " << processId << "\n";
-}
+    if (first != total) return in.fail();
 
-int MemoryManager::findVictimPage() {
-    switch (replacementPolicy) {
-        case PageReplacement::FIFO:
-            while (!fifoQueue.empty()) {
-                int pageIndex = fifoQueue.front();
-                fifoQueue.pop();
-                if (pageTable[pageIndex].processId != -1) {
-                    return pageIndex;
-                }
-            }
-            break;
-            
-        case PageReplacement::LRU:
-            {
-                int lruPage = -1;
-                int minTime = accessCounter + 1;
-                
-                for (int i = 0; i < totalPages; ++i) {
-                    if (pageTable[i].processId != -1 && pageUsage[i] < minTime) {
-                        minTime = pageUsage[i];
-                        lruPage = i;
-                    }
-                }
-                return lruPage;
+    uint64_t pageCount;
+    if (!in.getCount(pageCount, sizeof(PageRecord)) || pageCount != static_cast<uint64_t>(total)) return in.fail();
+    std::vector<Page> loadedTable(total);
+    std::vector<PageRecord> chunk;
+    for (size_t start = 0; start < loadedTable.size(); start += PAGE_RECORD_CHUNK) {
+        chunk.resize(std::min(PAGE_RECORD_CHUNK, loadedTable.size() - start));
+        if (!in.getRaw(chunk.data(), chunk.size())) return false;
+        for (size_t i = 0; i < chunk.size(); ++i) {
+            const PageRecord &record = chunk[i];
+            if (record.processId < -1 || record.mapCount < 0) return in.fail();
+            Page &page = loadedTable[start + i];
+            page.pageId = record.pageId;
+            page.processId = record.processId;
+            page.referenced = record.referenced != 0;
+            page.modified.store(record.modified != 0, std::memory_order_relaxed);
+            page.huge.store(record.huge != 0, std::memory_order_relaxed);
+            page.prefetched.store(record.prefetched != 0, std::memory_order_relaxed);
+            page.mapCount.store(record.mapCount, std::memory_order_relaxed);
+            page.lastUsed.store(record.lastUsed, std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<int> owners, fifoPrev, fifoNext;
+    std::vector<char> demand;
+    std::vector<long long> stamps;
+    int fifoHead, fifoTail;
+    if (!in.getVector(owners) || !in.getVector(demand) || !in.getVector(stamps) || !in.getVector(fifoPrev) ||
+        !in.getVector(fifoNext) || !in.get(fifoHead) || !in.get(fifoTail)) {
+        return false;
+    }
+    size_t size = static_cast<size_t>(total);
+    if (owners.size() != size || demand.size() != size || stamps.size() != size || fifoPrev.size() != size ||
+        fifoNext.size() != size || fifoHead < -1 || fifoHead >= total || fifoTail < -1 || fifoTail >= total) {
+        return in.fail();
+    }
+    for (size_t frame = 0; frame < size; ++frame) {
+        if (owners[frame] < -1 || fifoPrev[frame] < -2 || fifoPrev[frame] >= total || fifoNext[frame] < -2 ||
+            fifoNext[frame] >= total) {
+            return in.fail();
+        }
+    }
+    // La lista de carga se recorre al rehacer el orden LRU: no puede tener ciclos
+    int listed = 0;
+    int last = -1;
+    for (int frame = fifoHead; frame != -1; frame = fifoNext[frame]) {
+        if (frame < 0 || ++listed > total) return in.fail();
+        last = frame;
+    }
+    if (last != fifoTail) return in.fail();
+
+    uint64_t entries;
+    std::map<int, ProcessFrames> loadedFrames;
+    if (!in.getCount(entries, sizeof(int) + 2 * sizeof(uint64_t))) return false;
+    for (uint64_t i = 0; i < entries; ++i) {
+        int processId;
+        ProcessFrames owned;
+        if (!in.get(processId) || !in.getVector(owned.blocks) || !in.getVector(owned.spare)) return false;
+        for (const FrameBlock &block : owned.blocks) {
+            if (!validFrame(block.start) || block.order < 0 || block.order > 30 ||
+                (1LL << block.order) > total - block.start) {
+                return in.fail();
             }
-            break;
-            
-        case PageReplacement::WORKING_SET:
-            return findWorkingSetVictim();
-            break;
+        }
+        for (int frame : owned.spare) {
+            if (!validFrame(frame)) return in.fail();
+        }
+        loadedFrames[processId] = std::move(owned);
     }
-    return -1;
+    std::unordered_map<int, std::vector<uint64_t>> loadedSharers;
+    size_t keys = 0;
+    if (!in.getCount(entries, sizeof(int) + sizeof(uint64_t))) return false;
+    for (uint64_t i = 0; i < entries; ++i) {
+        int frame;
+        std::vector<uint64_t> sharers;
+        if (!in.get(frame) || !in.getVector(sharers)) return false;
+        if (!validFrame(frame) || sharers.empty()) return in.fail();
+        keys += sharers.size();
+        loadedSharers[frame] = std::move(sharers);
+    }
+    std::unordered_map<int, int> loadedHomes;
+    if (!in.getCount(entries, 2 * sizeof(int))) return false;
+    for (uint64_t i = 0; i < entries; ++i) {
+        int processId, node;
+        if (!in.get(processId) || !in.get(node)) return false;
+        if (node < 0 || node >= count) return in.fail();
+        loadedHomes[processId] = node;
+    }
+
+    commit = makeSnapshotCommit([=, loadedNodes = std::move(loadedNodes), loadedTable = std::move(loadedTable),
+                                 owners = std::move(owners), demand = std::move(demand), stamps = std::move(stamps),
+                                 fifoPrev = std::move(fifoPrev), fifoNext = std::move(fifoNext),
+                                 loadedFrames = std::move(loadedFrames), loadedSharers = std::move(loadedSharers),
+                                 loadedHomes = std::move(loadedHomes)]() mutable {
+        stopHugePageDaemon();
+        disableSwap();
+        {
+            std::lock_guard<std::mutex> lock(readaheadLock);
+            streams.clear();
+        }
+        std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+        std::lock_guard<std::mutex> lock(replacementLock);
+        totalPages = total;
+        nodeCount = count;
+        numaPolicy = numa;
+        replacementPolicy = policy;
+        workingSetWindow = window;
+        readaheadEnabled = readahead;
+        hugePageOrder = hugeOrder;
+        hugePageThreshold = hugeThreshold;
+        tlbEnabled = tlb;
+        nodes = std::move(loadedNodes);
+        frameNode.assign(size, 0);
+        for (int node = 0; node < nodeCount; ++node) {
+            std::fill(frameNode.begin() + nodes[node]->firstFrame,
+                      frameNode.begin() + nodes[node]->firstFrame + nodes[node]->frames, node);
+        }
+        frameCaches.reset(new FrameCache[cpuCount * nodeCount]);
+        pageTable = std::move(loadedTable);
+        frameOwner = std::move(owners);
+        demandFrame = std::move(demand);
+        hugeStamp = std::move(stamps);
+        fifoList.prev = std::move(fifoPrev);
+        fifoList.next = std::move(fifoNext);
+        fifoList.head = fifoHead;
+        fifoList.tail = fifoTail;
+        processFrames = std::move(loadedFrames);
+        frameSharers = std::move(loadedSharers);
+        homeNodes = std::move(loadedHomes);
+
+        usedPages = static_cast<int>(counters.usedPages);
+        residentPages = static_cast<int>(counters.residentPages);
+        spareFrames = static_cast<int>(counters.spareFrames);
+        accessCounter = counters.accessCounter;
+        pageFaults = counters.pageFaults;
+        pageHits = counters.pageHits;
+        sharedMappings = counters.sharedMappings;
+        forkedPages = counters.forkedPages;
+        cowFaults = counters.cowFaults;
+        hugePages = static_cast<int>(counters.hugePages);
+        hugePromotions = counters.hugePromotions;
+        hugeSplits = counters.hugeSplits;
+        tlbMisses = counters.tlbMisses;
+        prefetchesIssued = counters.prefetchesIssued;
+        prefetchesUseful = counters.prefetchesUseful;
+        prefetchesWasted = counters.prefetchesWasted;
+        pageIns = counters.pageIns;
+        pageInNanos = counters.pageInNanos;
+        writeBacks = counters.writeBacks;
+        writeBackNanos = counters.writeBackNanos;
+        swapErrors = counters.swapErrors;
+
+        // Índice (proceso, página) -> marco: una clave por página residente más las
+        // de los procesos que comparten un marco
+        pageIndex.init(std::max(total, static_cast<int>(std::min<size_t>(size + keys, 0x3fffffff))));
+        for (int frame = 0; frame < total; ++frame) {
+            const Page &page = pageTable[frame];
+            if (page.processId != -1) pageIndex.insert(makeKey(page.processId, page.pageId), frame);
+        }
+        for (const auto &[frame, sharers] : frameSharers) {
+            for (uint64_t key : sharers) pageIndex.insert(key, frame);
+        }
+        lruList.init(total);
+        lruStamp.assign(size, -1);
+        lruRefreshed = StampHeap();
+        if (replacementPolicy != PageReplacement::FIFO) rebuildLruOrder();
+        optActive = false;
+        optNextUse.assign(size, NEVER_USED);
+        optHeap = std::priority_queue<std::pair<long long, int>>();
+        for (int cpu = 0; cpu < cpuCount; ++cpu) {
+            for (auto &tag : tlbs[cpu].tags) tag.store(TLB_EMPTY, std::memory_order_relaxed);
+        }
+    });
+    return true;
 }
 
-int MemoryManager::findWorkingSetVictim() {
-    int victim = -1;
-    int oldestAccess = accessCounter + 1;
-    
-    for (int i = 0; i < totalPages; ++i) {
-        if (pageTable[i].processId != -1) {
-            // Calcular working set: páginas accedidas en la ventana de tiempo
-            int recentAccesses = 0;
-            for (int access : pageTable[i].accessHistory) {
-                if (access > (accessCounter - workingSetWindow)) {
-                    recentAccesses++;
+// ---------------- NUMA ----------------
+
+bool MemoryManager::configureNuma(int count, int localLatencyNs, int remoteLatencyNs) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    if (count < 1 || count > MAX_NODES || count > totalPages) {
+        std::cout << "❌ Número de nodos inválido (1-" << MAX_NODES << ", como máximo uno por marco)\n";
+        return false;
+    }
+    if (localLatencyNs <= 0 || remoteLatencyNs <= 0) {
+        std::cout << "❌ Las latencias deben ser positivas\n";
+        return false;
+    }
+    if (usedPages > 0 || residentPages > 0) {
+        std::cout << "❌ Hay memoria asignada: libere los procesos antes de cambiar los nodos\n";
+        return false;
+    }
+    drainFrameCaches();
+    buildNodes(count);
+    homeNodes.clear();
+    for (auto &node : nodes) {
+        node->localLatencyNs = localLatencyNs;
+        node->remoteLatencyNs = remoteLatencyNs;
+    }
+    std::cout << "🧭 Memoria repartida en " << count << " nodo(s) de ~" << totalPages / count
+              << " marcos | Latencia local: " << localLatencyNs << " ns | remota: " << remoteLatencyNs << " ns\n";
+    return true;
+}
+
+bool MemoryManager::setNodeLatency(int node, int localLatencyNs, int remoteLatencyNs) {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    if (node < 0 || node >= nodeCount || localLatencyNs <= 0 || remoteLatencyNs <= 0) {
+        std::cout << "❌ Nodo o latencias inválidos\n";
+        return false;
+    }
+    nodes[node]->localLatencyNs = localLatencyNs;
+    nodes[node]->remoteLatencyNs = remoteLatencyNs;
+    return true;
+}
+
+int MemoryManager::getNodeCount() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return nodeCount;
+}
+
+int MemoryManager::getNodeLatency(int node, bool remote) const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    if (node < 0 || node >= nodeCount) return 0;
+    return remote ? nodes[node]->remoteLatencyNs : nodes[node]->localLatencyNs;
+}
+
+void MemoryManager::setNumaPolicy(NumaPolicy policy) {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    numaPolicy = policy;
+    std::cout << "🧭 Política de asignación NUMA: " << numaPolicyName(policy) << "\n";
+}
+
+NumaPolicy MemoryManager::getNumaPolicy() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return numaPolicy;
+}
+
+void MemoryManager::setHomeNode(int processId, int node) {
+    std::unique_lock<std::shared_mutex> table = lockTableExclusive();
+    if (node < 0) homeNodes.erase(processId);
+    else if (node < nodeCount) homeNodes[processId] = node;
+}
+
+int MemoryManager::getHomeNode(int processId) const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return homeNodeOf(processId);
+}
+
+// Ubicación inicial de un proceso nuevo: el nodo con más marcos libres
+int MemoryManager::leastLoadedNode() const {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    int best = 0;
+    int bestFree = -1;
+    for (int node = 0; node < nodeCount; ++node) {
+        int free = nodes[node]->buddy.getFreeFrames() + nodes[node]->cachedFrames.load();
+        if (free > bestFree) {
+            best = node;
+            bestFree = free;
+        }
+    }
+    return best;
+}
+
+// Pasada tipo khugepaged (tabla en exclusiva). Con poca memoria libre divide las
+// páginas enormes que tienen subpáginas sin usar y las libera; si no, promueve las
+// regiones alineadas más densas mientras el buddy tenga bloques de ese tamaño
+int MemoryManager::collapseHugePages() {
+    if (hugePageOrder == 0) return 0;
+    std::lock_guard<std::mutex> lock(replacementLock);
+    drainFrameCaches();
+    int regionSize = 1 << hugePageOrder;
+
+    if (freeFrameCount() < std::max(1, totalPages / 16)) {
+        for (int start = 0; start < totalPages; ++start) {
+            if (!pageTable[start].huge.load(std::memory_order_relaxed) || hugeStartOf(start) != start) continue;
+            std::vector<int> untouched;
+            for (int frame = start; frame < start + regionSize; ++frame) {
+                if (pageTable[frame].lastUsed.load(std::memory_order_relaxed) == hugeStamp[start]) {
+                    untouched.push_back(frame);
                 }
             }
-            
-            // Si no ha sido accedida recientemente, es candidata
-            if (recentAccesses == 0 && pageTable[i].lastUsed < oldestAccess) {
-                oldestAccess = pageTable[i].lastUsed;
-                victim = i;
-            }
+            if (untouched.empty()) continue;
+            splitHugePage(start);
+            for (int frame : untouched) dropPage(frame);
         }
+        refreshExhausted();
+        return 0;
     }
-    
-    // Si no encontramos página fuera del working set, usar LRU
-    if (victim == -1) {
-        for (int i = 0; i < totalPages; ++i) {
-            if (pageTable[i].processId != -1 && pageTable[i].lastUsed < oldestAccess) {
-                oldestAccess = pageTable[i].lastUsed;
-                victim = i;
+
+    // Páginas base residentes por región alineada (proceso, página >> orden)
+    std::unordered_map<uint64_t, int> resident;
+    for (int frame = 0; frame < totalPages; ++frame) {
+        const Page &page = pageTable[frame];
+        if (page.processId == -1 || pageTable[frame].huge.load(std::memory_order_relaxed) ||
+            page.mapCount.load(std::memory_order_relaxed) > 1) {
+            continue;
+        }
+        resident[makeKey(page.processId, page.pageId >> hugePageOrder)]++;
+    }
+    std::vector<std::pair<int, uint64_t>> candidates;
+    for (const auto &[region, count] : resident) {
+        if (count * 100 >= hugePageThreshold * regionSize) candidates.push_back({count, region});
+    }
+    // Primero las más densas; el desempate por región hace la pasada reproducible
+    std::sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    int promoted = 0;
+    for (const auto &[count, region] : candidates) {
+        int processId = static_cast<int>(region >> 32);
+        int firstPage = static_cast<int>(static_cast<uint32_t>(region)) << hugePageOrder;
+        // Tampoco una región con páginas compartidas tras un fork: moverlas afectaría a los otros procesos
+        bool shared = false;
+        for (int page = firstPage; page < firstPage + regionSize && !shared; ++page) {
+            int frame = lookupFrame(makeKey(processId, page));
+            shared = frame != -1 && pageTable[frame].mapCount.load(std::memory_order_relaxed) > 1;
+        }
+        if (shared) continue;
+        // Como max_ptes_swap = 0: no se promueve una región con páginas en el swap
+        if (swap) {
+            bool swapped = false;
+            std::lock_guard<std::mutex> swapLock(swapMutex);
+            for (int page = firstPage; page < firstPage + regionSize && !swapped; ++page) {
+                uint64_t key = makeKey(processId, page);
+                swapped = lookupFrame(key) == -1 && swap->slotFor(key) != -1;
             }
+            if (swapped) continue;
         }
+        int start = allocateBlock(hugePageOrder, processId, firstPage);
+        if (start == -1) continue;
+        collapseRegion(region, start);
+        promoted++;
     }
-    
-    return victim;
+    refreshExhausted();
+    return promoted;
 }
 
-void MemoryManager::updatePageUsage(int pageIndex) {
-    pageTable[pageIndex].referenced = true;
-    pageTable[pageIndex].lastUsed = accessCounter;
-    pageUsage[pageIndex] = accessCounter++;
+// Copia las páginas de la región al bloque contiguo y carga las que faltan
+// (con replacementLock). Las que nunca se usaron conservan la marca de la promoción
+void MemoryManager::collapseRegion(uint64_t region, int start) {
+    int regionSize = 1 << hugePageOrder;
+    int processId = static_cast<int>(region >> 32);
+    int firstPage = static_cast<int>(static_cast<uint32_t>(region)) << hugePageOrder;
+    long long stamp = accessCounter++;
+    hugeStamp[start] = stamp;
+
+    for (int offset = 0; offset < regionSize; ++offset) {
+        int virtualPage = firstPage + offset;
+        int old = lookupFrame(makeKey(processId, virtualPage));
+        long long lastUsed = stamp;
+        bool dirty = false;
+        bool prefetched = false;
+        if (old != -1) {
+            lastUsed = pageTable[old].lastUsed.load(std::memory_order_relaxed);
+            dirty = pageTable[old].modified.load(std::memory_order_relaxed);
+            prefetched = pageTable[old].prefetched.exchange(false, std::memory_order_relaxed);
+            dropPage(old);
+        }
+        int frame = start + offset;
+        frameOwner[frame] = processId;
+        pageTable[frame].huge.store(true, std::memory_order_relaxed);
+        mapPage(frame, processId, virtualPage, lastUsed, dirty, prefetched);
+    }
+    processFrames[processId].blocks.push_back(FrameBlock{start, hugePageOrder, regionSize});
+    usedPages += regionSize;
+    hugePages++;
+    hugePromotions++;
 }
 
-void MemoryManager::updateWorkingSet(int pageIndex) {
-    pageTable[pageIndex].referenced = true;
-    pageTable[pageIndex].lastUsed = accessCounter;
-    pageTable[pageIndex].accessHistory.push_back(accessCounter);
-    
-    // Mantener solo los últimos accesos en el historial
-    if (pageTable[pageIndex].accessHistory.size() > 10) {
-        pageTable[pageIndex].accessHistory.erase(
-            pageTable[pageIndex].accessHistory.begin()
-        );
+// Primer marco del bloque de página enorme que contiene al marco (los bloques
+// están alineados dentro de su nodo)
+int MemoryManager::hugeStartOf(int frame) const {
+    int first = nodes[frameNode[frame]]->firstFrame;
+    return first + ((frame - first) & ~((1 << hugePageOrder) - 1));
+}
+
+// Divide la página enorme: sus marcos pasan a ser marcos sueltos del proceso y
+// cada subpágina se reemplaza por separado (con replacementLock)
+void MemoryManager::splitHugePage(int start) {
+    int regionSize = 1 << hugePageOrder;
+    const Page &head = pageTable[start];
+    tlbShootdown(hugeTag(makeKey(head.processId, head.pageId)));
+    for (int frame = start; frame < start + regionSize; ++frame) {
+        pageTable[frame].huge.store(false, std::memory_order_relaxed);
+        demandFrame[frame] = 1;
     }
-    
-    accessCounter++;
+    {
+        std::lock_guard<std::mutex> lock(allocLock);
+        auto it = processFrames.find(frameOwner[start]);
+        if (it != processFrames.end()) {
+            std::vector<FrameBlock> &blocks = it->second.blocks;
+            blocks.erase(std::remove_if(blocks.begin(), blocks.end(),
+                                        [start](const FrameBlock &block) { return block.start == start; }),
+                         blocks.end());
+        }
+    }
+    hugePages--;
+    hugeSplits++;
 }
 
-void MemoryManager::accessPage(int processId, int virtualPage) {
-    // Buscar página en memoria
-    for (int i = 0; i < totalPages; ++i) {
-        if (pageTable[i].processId == processId && pageTable[i].pageId == virtualPage) {
-            if (replacementPolicy == PageReplacement::WORKING_SET) {
-                updateWorkingSet(i);
-            } else {
-                updatePageUsage(i);
-            }
-            pageHits++;
-            std::cout << "✅ HIT - Página " << virtualPage << " del proceso " << processId 
-                      << " en marco " << i << " | Hits: " << pageHits << " | Faults: " << pageFaults << "\n";
-            return;
+// Antes de liberar páginas del proceso sus páginas enormes se dividen (con replacementLock)
+void MemoryManager::splitProcessHugePages(int processId) {
+    auto it = processFrames.find(processId);
+    if (it == processFrames.end() || hugePageOrder == 0) return;
+    std::vector<FrameBlock> blocks = it->second.blocks;
+    for (const FrameBlock &block : blocks) {
+        if (pageTable[block.start].huge.load(std::memory_order_relaxed)) splitHugePage(block.start);
+    }
+}
+
+// Subpáginas cargadas por una promoción que no se han usado desde entonces
+int MemoryManager::countBloatPages() const {
+    if (hugePageOrder == 0) return 0;
+    int regionSize = 1 << hugePageOrder;
+    int bloat = 0;
+    for (int start = 0; start < totalPages; ++start) {
+        if (!pageTable[start].huge.load(std::memory_order_relaxed) || hugeStartOf(start) != start) continue;
+        for (int frame = start; frame < start + regionSize; ++frame) {
+            if (pageTable[frame].lastUsed.load(std::memory_order_relaxed) == hugeStamp[start]) bloat++;
         }
     }
-    
-    // Page fault - necesitamos cargar la página
-    pageFaults++;
-    std::cout << "❌ PAGE FAULT - Página " << virtualPage << " del proceso " << processId 
-              << " | Hits: " << pageHits << " | Faults: " << pageFaults << "\n";
-    
-    // Encontrar marco libre o víctima
-    int freeFrame = -1;
-    for (int i = 0; i < totalPages; ++i) {
-        if (pageTable[i].processId == -1) {
-            freeFrame = i;
-            break;
+    return bloat;
+}
+
+AccessResult MemoryManager::replayTrace(const ReferenceTrace& trace) {
+    auto start = std::chrono::steady_clock::now();
+    AccessResult result{0, 0};
+    if (getHugePageOrder() > 0 && getReplacementPolicy() != PageReplacement::OPT) {
+        // khugepaged se despierta cada HUGE_SCAN_REFS referencias (tiempo virtual: reproducible)
+        for (size_t offset = 0; offset < trace.refs.size(); offset += HUGE_SCAN_REFS) {
+            size_t count = std::min(HUGE_SCAN_REFS, trace.refs.size() - offset);
+            AccessResult partial = accessPages(trace.refs.data() + offset, count);
+            result.hits += partial.hits;
+            result.faults += partial.faults;
+            promoteHugePages();
         }
+    } else {
+        result = accessPages(trace.refs);
     }
-    
-    if (freeFrame == -1) {
-        freeFrame = findVictimPage();
-        std::cout << "🔁 Reemplazando página en marco " << freeFrame 
-                  << " (Proceso " << pageTable[freeFrame].processId 
-                  << ", Página " << pageTable[freeFrame].pageId << ")\n";
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "\n--- REPRODUCCIÓN DE TRAZA ---\n";
+    std::cout << "Referencias: " << trace.refs.size() << " | Marcos: " << totalPages << "\n";
+    std::cout << "Hits: " << result.hits << " | Faults: " << result.faults << "\n";
+    std::cout << "Tiempo: " << seconds * 1000.0 << " ms";
+    if (seconds > 0) {
+        std::cout << " | " << (trace.refs.size() / seconds) / 1e6 << " M refs/s";
     }
-    
-    // Cargar nueva página
-    pageTable[freeFrame].processId = processId;
-    pageTable[freeFrame].pageId = virtualPage;
-    pageTable[freeFrame].referenced = true;
-    pageTable[freeFrame].modified = false;
-    
-    if (replacementPolicy == PageReplacement::WORKING_SET) {
-        updateWorkingSet(freeFrame);
-    } else {
-        updatePageUsage(freeFrame);
+    std::cout << "\n";
+    return result;
+}
+
+// Lee el siguiente entero en [p, end); devuelve false si no hay más
+static bool parseNextInt(const char*& p, const char* end, int& value) {
+    while (p < end && !(*p >= '0' && *p <= '9') && *p != '-') ++p;
+    if (p >= end) return false;
+    bool negative = false;
+    if (*p == '-') {
+        negative = true;
+        ++p;
+        if (p >= end || !(*p >= '0' && *p <= '9')) return parseNextInt(p, end, value);
     }
-    
-    if (replacementPolicy == PageReplacement::FIFO) {
-        fifoQueue.push(freeFrame);
+    int v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        ++p;
+    }
+    value = negative ? -v : v;
+    return true;
+}
+
+// Sufijo opcional "w" tras la página: acceso de escritura
+static bool parseWriteMark(const char*& p, const char* end) {
+    const char* q = p;
+    while (q < end && (*q == ' ' || *q == '\t')) ++q;
+    if (q < end && (*q == 'w' || *q == 'W')) {
+        p = q + 1;
+        return true;
+    }
+    return false;
+}
+
+static bool lineContains(const char* begin, const char* end, const char* text) {
+    size_t n = std::strlen(text);
+    for (const char* p = begin; p + n <= end; ++p) {
+        if (std::memcmp(p, text, n) == 0) return true;
+    }
+    return false;
+}
+
+bool MemoryManager::loadReferenceTrace(const std::string& path, ReferenceTrace& trace) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cout << "❌ No se pudo abrir la traza '" << path << "'\n";
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    std::string buffer(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0, std::ios::beg);
+    in.read(&buffer[0], buffer.size());
+
+    trace = ReferenceTrace();
+    trace.refs.reserve(buffer.size() / 4);
+
+    // Formatos aceptados:
+    //   "Proceso P -> a b c ..."          (scripts/mem_fifo.txt)
+    //   "Accesos del proceso P:" + línea  (scripts/mem_ws.txt)
+    //   "P pagina" por línea              (trazas masivas)
+    // Una "w" tras la página indica escritura (p. ej. "3w" o "1 3 w")
+    int currentProcess = -1;
+    const char* p = buffer.data();
+    const char* bufferEnd = p + buffer.size();
+    while (p < bufferEnd) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', bufferEnd - p));
+        if (!lineEnd) lineEnd = bufferEnd;
+        const char* line = p;
+        while (line < lineEnd && (*line == ' ' || *line == '\t')) ++line;
+        p = lineEnd + 1;
+        if (line >= lineEnd || *line == '\r' || *line == '#') continue;
+
+        int value;
+        if (*line >= '0' && *line <= '9') {
+            const char* q = line;
+            if (currentProcess != -1) {
+                while (parseNextInt(q, lineEnd, value)) {
+                    trace.refs.push_back(PageRef{currentProcess, value, parseWriteMark(q, lineEnd)});
+                }
+            } else {
+                int processId;
+                while (parseNextInt(q, lineEnd, processId) && parseNextInt(q, lineEnd, value)) {
+                    trace.refs.push_back(PageRef{processId, value, parseWriteMark(q, lineEnd)});
+                }
+            }
+        } else if (lineContains(line, lineEnd, "->")) {
+            const char* arrow = line;
+            while (arrow + 1 < lineEnd && !(arrow[0] == '-' && arrow[1] == '>')) ++arrow;
+            const char* q = line;
+            int processId;
+            if (!parseNextInt(q, arrow, processId)) continue;
+            q = arrow + 2;
+            while (parseNextInt(q, lineEnd, value)) {
+                trace.refs.push_back(PageRef{processId, value, parseWriteMark(q, lineEnd)});
+            }
+        } else if (lineContains(line, lineEnd, "POL")) {
+            if (lineContains(line, lineEnd, "FIFO")) trace.policy = PageReplacement::FIFO;
+            else if (lineContains(line, lineEnd, "LRU")) trace.policy = PageReplacement::LRU;
+            else if (lineContains(line, lineEnd, "Working") || lineContains(line, lineEnd, "WORKING"))
+                trace.policy = PageReplacement::WORKING_SET;
+            else continue;
+            trace.hasPolicy = true;
+        } else if (lineContains(line, lineEnd, "Marcos")) {
+            const char* q = line;
+            if (parseNextInt(q, lineEnd, value)) trace.frames = value;
+        } else if (lineContains(line, lineEnd, "Ventana")) {
+            const char* q = line;
+            if (parseNextInt(q, lineEnd, value)) trace.window = value;
+        } else if (lineContains(line, lineEnd, "roceso")) {
+            const char* q = line;
+            currentProcess = parseNextInt(q, lineEnd, value) ? value : -1;
+        } else {
+            currentProcess = -1;
+        }
     }
+
+    std::cout << "📄 Traza cargada: " << trace.refs.size() << " referencias\n";
+    return true;
 }
 
 int MemoryManager::getUsedPages() const {
-    return usedPages;
+    return usedPages.load();
 }
 
 int MemoryManager::getTotalPages() const {
@@ -220,6 +2515,7 @@ int MemoryManager::getTotalPages() const {
 }
 
 void MemoryManager::showMemoryStatus() const {
+    std::unique_lock<std::shared_mutex> table(tableLock);
     std::cout << "\n--- ESTADO DE MEMORIA ---\n";
     std::cout << "Memoria usada: " << usedPages << "/" << totalPages << " páginas\n";
     
@@ -228,24 +2524,86 @@ void MemoryManager::showMemoryStatus() const {
         case PageReplacement::FIFO: policyName = "FIFO"; break;
         case PageReplacement::LRU: policyName = "LRU"; break;
         case PageReplacement::WORKING_SET: policyName = "WORKING SET"; break;
+        case PageReplacement::OPT: policyName = "OPT (Belady)"; break;
     }
     std::cout << "Política de reemplazo: " << policyName << "\n";
+
+    // Fragmentación interna: marcos asignados sin página cargada.
+    // Fragmentación externa: parte de la memoria libre fuera del mayor bloque libre.
+    int cached = 0;
+    int largest = 0;
+    int maxOrder = 0;
+    for (const auto &node : nodes) {
+        cached += node->cachedFrames.load();
+        largest = std::max(largest, node->buddy.largestFreeBlock());
+        maxOrder = std::max(maxOrder, node->buddy.getMaxOrder());
+    }
+    int freeFrames = freeFrameCount() + cached;
+    int internal = usedPages - residentPages;
+    double internalPct = usedPages > 0 ? (double)internal / usedPages * 100.0 : 0.0;
+    double externalPct = freeFrames > 0 ? (1.0 - (double)largest / freeFrames) * 100.0 : 0.0;
+    std::cout << "Páginas residentes: " << residentPages << " | Marcos asignados sin uso: " << internal
+              << " (fragmentación interna " << internalPct << "%)\n";
+    std::cout << "Marcos libres: " << freeFrames << " | Mayor bloque libre: " << largest
+              << " (fragmentación externa " << externalPct << "%)\n";
+    std::cout << "Bloques libres por orden:";
+    for (int order = 0; order <= maxOrder; ++order) {
+        int blocks = 0;
+        for (const auto &node : nodes) {
+            if (order <= node->buddy.getMaxOrder()) blocks += node->buddy.freeBlocksOfOrder(order);
+        }
+        std::cout << " 2^" << order << ":" << blocks;
+    }
+    std::cout << "\n";
+    if (cached > 0) {
+        std::cout << "Marcos en cachés por CPU: " << cached << " (" << cpuCount << " CPUs)\n";
+    }
+    if (nodeCount > 1) {
+        std::cout << "Nodos NUMA (política " << numaPolicyName(numaPolicy) << "):\n";
+        for (int node = 0; node < nodeCount; ++node) {
+            const MemoryNode &memory = *nodes[node];
+            std::cout << "  Nodo " << node << ": marcos " << memory.firstFrame << "-"
+                      << memory.firstFrame + memory.frames - 1 << " | Libres: "
+                      << memory.buddy.getFreeFrames() + memory.cachedFrames.load()
+                      << " | Latencia local " << memory.localLatencyNs << " ns, remota "
+                      << memory.remoteLatencyNs << " ns\n";
+        }
+    }
     
-    showStatistics();
+    printStatistics();
 }
 
-void MemoryManager::setReplacementPolicy(PageReplacement policy) {
+void MemoryManager::setReplacementPolicy(PageReplacement policy, bool verbose) {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    // Con FIFO no se mantiene el orden LRU: se reconstruye al salir de FIFO
+    bool rebuild = replacementPolicy == PageReplacement::FIFO && policy != PageReplacement::FIFO;
     replacementPolicy = policy;
+    if (rebuild) {
+        std::lock_guard<std::mutex> lock(replacementLock);
+        rebuildLruOrder();
+    }
+    if (!verbose) return;
     std::string policyName;
     switch (policy) {
         case PageReplacement::FIFO: policyName = "FIFO"; break;
         case PageReplacement::LRU: policyName = "LRU"; break;
         case PageReplacement::WORKING_SET: policyName = "WORKING SET"; break;
+        case PageReplacement::OPT: policyName = "OPT (Belady)"; break;
     }
     std::cout << "Política de reemplazo cambiada a " << policyName << "\n";
+    if (policy == PageReplacement::OPT) {
+        std::cout << "💡 OPT necesita conocer las referencias futuras: se aplica al reproducir trazas; "
+                  << "los accesos individuales usan LRU.\n";
+    }
+}
+
+PageReplacement MemoryManager::getReplacementPolicy() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    return replacementPolicy;
 }
 
 void MemoryManager::showPageTable() const {
+    std::unique_lock<std::shared_mutex> table(tableLock);
     std::cout << "\n--- TABLA DE PÁGINAS (Visualización con Colores) ---\n";
     
     // Estadísticas por proceso
@@ -266,13 +2624,16 @@ void MemoryManager::showPageTable() const {
     for (int i = 0; i < totalPages; i += 8) {
         for (int j = 0; j < 8 && i + j < totalPages; ++j) {
             int idx = i + j;
-            if (pageTable[idx].processId == -1) {
+            if (pageTable[idx].processId == -1 && frameOwner[idx] != -1) {
+                std::cout << "[\033[90mR-P" << frameOwner[idx] << "\033[0m] ";  // Reservado sin página
+            } else if (pageTable[idx].processId == -1) {
                 std::cout << "[\033[90m Libre \033[0m] ";  // Gris
             } else {
                 // Color diferente por proceso
                 int colorCode = 31 + (pageTable[idx].processId % 6); // 31-36: rojo, verde, amarillo, azul, magenta, cian
                 std::cout << "[\033[" << colorCode << "mP" << pageTable[idx].processId 
-                          << "-" << pageTable[idx].pageId << "\033[0m] ";
+                          << "-" << pageTable[idx].pageId
+                          << (pageTable[idx].mapCount.load(std::memory_order_relaxed) > 1 ? "*" : "") << "\033[0m] ";
             }
         }
         std::cout << "\n";
@@ -284,25 +2645,32 @@ void MemoryManager::showPageTable() const {
         int colorCode = 31 + (pid % 6);
         std::cout << "[\033[" << colorCode << "mP" << pid << "\033[0m] ";
     }
-    std::cout << "[\033[90mLibre\033[0m]\n";
+    std::cout << "[\033[90mLibre\033[0m] [\033[90mR-P = reservado sin página\033[0m] [* = compartido (copy-on-write)]\n";
 }
 
 void MemoryManager::showStatistics() const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    printStatistics();
+}
+
+void MemoryManager::printStatistics() const {
     std::cout << "\n--- ESTADÍSTICAS DE MEMORIA ---\n";
-    int totalAccesses = pageHits + pageFaults;
-    double hitRate = totalAccesses > 0 ? (double)pageHits / totalAccesses * 100.0 : 0.0;
-    double faultRate = totalAccesses > 0 ? (double)pageFaults / totalAccesses * 100.0 : 0.0;
+    long long hits = pageHits.load();
+    long long faults = pageFaults.load();
+    long long totalAccesses = hits + faults;
+    double hitRate = totalAccesses > 0 ? (double)hits / totalAccesses * 100.0 : 0.0;
+    double faultRate = totalAccesses > 0 ? (double)faults / totalAccesses * 100.0 : 0.0;
     
     std::cout << "Total de accesos: " << totalAccesses << "\n";
-    std::cout << "Page Hits: " << pageHits << " (" << hitRate << "%)\n";
-    std::cout << "Page Faults: " << pageFaults << " (" << faultRate << "%)\n";
-    
+    std::cout << "Page Hits: " << hits << " (" << hitRate << "%)\n";
+    std::cout << "Page Faults: " << faults << " (" << faultRate << "%)\n";
+
     // Gráfico simple de hits vs faults
     if (totalAccesses > 0) {
         std::cout << "📊 Distribución: ";
         int totalBars = 20;
-        int hitBars = (pageHits * totalBars) / totalAccesses;
-        int faultBars = (pageFaults * totalBars) / totalAccesses;
+        int hitBars = (hits * totalBars) / totalAccesses;
+        int faultBars = (faults * totalBars) / totalAccesses;
         
         std::cout << "\033[32m"; // Verde para hits
         for (int i = 0; i < hitBars; ++i) std::cout << "█";
@@ -312,9 +2680,253 @@ void MemoryManager::showStatistics() const {
         
         std::cout << "            \033[32mHits\033[0m  \033[31mFaults\033[0m\n";
     }
+
+    // TLB: fallos medidos y alcance (memoria que cubren sus entradas)
+    if (tlbEnabled) {
+        long long misses = tlbMisses.load();
+        double tlbMissRate = totalAccesses > 0 ? (double)misses / totalAccesses * 100.0 : 0.0;
+        long long huge = hugePages.load();
+        long long hugeEntries = std::min<long long>(huge, CpuTlb::ENTRIES);
+        long long hugeBytes = static_cast<long long>(SwapSpace::PAGE_SIZE) << hugePageOrder;
+        long long reach = hugeEntries * hugeBytes + (CpuTlb::ENTRIES - hugeEntries) * SwapSpace::PAGE_SIZE;
+        std::cout << "🔎 TLB (" << CpuTlb::ENTRIES << " entradas por CPU): " << misses << " fallos ("
+                  << tlbMissRate << "%) | Alcance: " << formatSize(reach) << "\n";
+    }
+    // NUMA: reparto de los accesos y latencia media según el nodo que sirvió cada uno
+    if (nodeCount > 1) {
+        long long local = 0;
+        long long remote = 0;
+        double nanos = 0.0;
+        for (const auto &node : nodes) {
+            long long nodeLocal = node->localAccesses.load();
+            long long nodeRemote = node->remoteAccesses.load();
+            local += nodeLocal;
+            remote += nodeRemote;
+            nanos += (double)nodeLocal * node->localLatencyNs + (double)nodeRemote * node->remoteLatencyNs;
+        }
+        long long accesses = local + remote;
+        double localPct = accesses > 0 ? (double)local / accesses * 100.0 : 0.0;
+        double remotePct = accesses > 0 ? (double)remote / accesses * 100.0 : 0.0;
+        std::cout << "🧭 NUMA (" << nodeCount << " nodos, " << numaPolicyName(numaPolicy) << "): accesos locales "
+                  << local << " (" << localPct << "%) | remotos " << remote << " (" << remotePct << "%)\n";
+        std::cout << "   Latencia media efectiva: " << (accesses > 0 ? nanos / accesses : 0.0) << " ns\n";
+        for (int node = 0; node < nodeCount; ++node) {
+            std::cout << "   Nodo " << node << ": " << nodes[node]->localAccesses.load() << " locales, "
+                      << nodes[node]->remoteAccesses.load() << " remotos\n";
+        }
+    }
+    if (forkedPages > 0) {
+        std::cout << "🍴 Copy-on-write: " << sharedMappings.load() << " marcos ahorrados | Fallos COW: "
+                  << cowFaults.load() << " | Páginas heredadas en forks: " << forkedPages.load() << "\n";
+    }
+    long long issued = prefetchesIssued.load();
+    if (readaheadEnabled || issued > 0) {
+        long long useful = prefetchesUseful.load();
+        long long wasted = prefetchesWasted.load();
+        double accuracy = useful + wasted > 0 ? (double)useful / (useful + wasted) * 100.0 : 0.0;
+        double coverage = useful + faults > 0 ? (double)useful / (useful + faults) * 100.0 : 0.0;
+        std::cout << "📚 Readahead: " << issued << " páginas precargadas | Útiles: " << useful
+                  << " | Desperdiciadas: " << wasted << "\n";
+        std::cout << "   Precisión: " << accuracy << "% | Cobertura: " << coverage << "% de los fallos evitados\n";
+    }
+    if (hugePageOrder > 0) {
+        long long hugeBytes = static_cast<long long>(SwapSpace::PAGE_SIZE) << hugePageOrder;
+        int bloat = countBloatPages();
+        std::cout << "🧱 Páginas enormes de " << formatSize(hugeBytes) << ": " << hugePages.load()
+                  << " activas | Promociones: " << hugePromotions.load() << " | Divisiones: " << hugeSplits.load() << "\n";
+        std::cout << "   Memoria inflada: " << bloat << " páginas ("
+                  << formatSize(static_cast<long long>(bloat) * SwapSpace::PAGE_SIZE) << ") cargadas sin usarse\n";
+    }
+
+    if (swap) {
+        long long ins = pageIns.load();
+        long long outs = writeBacks.load();
+        double inLatency = ins > 0 ? pageInNanos.load() / 1000.0 / ins : 0.0;
+        double megabytes = outs * (double)SwapSpace::PAGE_SIZE / (1024.0 * 1024.0);
+        double writeSeconds = writeBackNanos.load() / 1e9;
+        int slots;
+        {
+            std::lock_guard<std::mutex> lock(swapMutex);
+            slots = swap->usedSlots();
+        }
+        std::cout << "💾 Swap: " << slots << " ranuras en '" << swap->getPath() << "'\n";
+        std::cout << "   Page-ins: " << ins << " | Latencia media: " << inLatency << " µs\n";
+        std::cout << "   Write-backs: " << outs << " (" << megabytes << " MiB)";
+        if (writeSeconds > 0) {
+            std::cout << " | Ancho de banda: " << megabytes / writeSeconds << " MiB/s";
+        }
+        std::cout << "\n";
+        if (swapErrors.load() > 0) {
+            std::cout << "   ⚠️  Errores de E/S en swap: " << swapErrors.load() << "\n";
+        }
+    }
+    
+    if (!missRatioCurve.empty()) {
+        std::cout << "\n--- CURVA DE TASA DE FALLOS (LRU) ---\n";
+        std::cout << "Referencias analizadas: " << missRatioReferences
+                  << " | Páginas distintas: " << missRatioCurve.size() - 1 << "\n";
+
+        // Mostrar como máximo ~16 filas repartidas sobre la curva
+        int maxFrames = static_cast<int>(missRatioCurve.size()) - 1;
+        int step = std::max(1, maxFrames / 16);
+        std::vector<int> rows;
+        for (int frames = 1; frames <= maxFrames; frames += step) rows.push_back(frames);
+        rows.push_back(maxFrames);
+        if (totalPages <= maxFrames) rows.push_back(totalPages);
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        for (int frames : rows) {
+            double ratio = missRatioCurve[frames];
+            std::cout << "Marcos " << frames << ": " << ratio * 100.0 << "% fallos ";
+            std::cout << "\033[31m";
+            for (int i = 0; i < static_cast<int>(ratio * 20); ++i) std::cout << "█";
+            std::cout << "\033[0m";
+            if (frames == totalPages) std::cout << " ◀ actual";
+            std::cout << "\n";
+        }
+    }
+}
+
+void MemoryManager::computeMissRatioCurve(const std::vector<PageRef>& refs) {
+    std::unique_lock<std::shared_mutex> table(tableLock);
+    auto start = std::chrono::steady_clock::now();
+    size_t n = refs.size();
+
+    // Distancia de pila = páginas distintas referenciadas desde el último uso + 1.
+    // El árbol marca con 1 la última referencia de cada página.
+    FenwickTree marks;
+    marks.init(n);
+    std::unordered_map<uint64_t, size_t> lastUse;
+    lastUse.reserve(n / 4 + 16);
+    std::vector<long long> distanceHistogram(1, 0);
+    long long coldMisses = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        auto [it, inserted] = lastUse.try_emplace(makeKey(refs[i].processId, refs[i].virtualPage), i);
+        if (inserted) {
+            coldMisses++;
+        } else {
+            size_t previous = it->second;
+            size_t distance = static_cast<size_t>(marks.prefixSum(i) - marks.prefixSum(previous + 1)) + 1;
+            if (distance >= distanceHistogram.size()) distanceHistogram.resize(distance + 1, 0);
+            distanceHistogram[distance]++;
+            marks.add(previous, -1);
+            it->second = i;
+        }
+        marks.add(i, 1);
+    }
+
+    // Con f marcos hay hit si la distancia es <= f
+    size_t distinctPages = lastUse.size();
+    missRatioCurve.assign(distinctPages + 1, 1.0);
+    long long hits = 0;
+    for (size_t frames = 1; frames <= distinctPages && n > 0; ++frames) {
+        if (frames < distanceHistogram.size()) hits += distanceHistogram[frames];
+        missRatioCurve[frames] = static_cast<double>(n - hits) / n;
+    }
+    missRatioReferences = n;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "📈 Curva de fallos LRU calculada en una pasada: " << n << " referencias, "
+              << distinctPages << " páginas distintas (" << coldMisses << " fallos obligatorios) en "
+              << seconds * 1000.0 << " ms\n";
+}
+
+const std::vector<double>& MemoryManager::getMissRatioCurve() const {
+    return missRatioCurve;
+}
+
+bool MemoryManager::exportMissRatioCurve(const std::string& path) const {
+    std::shared_lock<std::shared_mutex> table(tableLock);
+    if (missRatioCurve.empty()) {
+        std::cout << "❌ No hay curva de fallos calculada\n";
+        return false;
+    }
+    std::ofstream out(path);
+    if (!out) {
+        std::cout << "❌ No se pudo crear el archivo '" << path << "'\n";
+        return false;
+    }
+    out << "marcos,tasa_fallos,fallos\n";
+    for (size_t frames = 1; frames < missRatioCurve.size(); ++frames) {
+        out << frames << "," << missRatioCurve[frames] << ","
+            << static_cast<long long>(missRatioCurve[frames] * missRatioReferences + 0.5) << "\n";
+    }
+    std::cout << "💾 Curva exportada a '" << path << "'\n";
+    return true;
 }
 
-void MemoryManager::setWorkingSetWindow(int window) {
+void MemoryManager::setWorkingSetWindow(int window, bool verbose) {
+    std::unique_lock<std::shared_mutex> table(tableLock);
     workingSetWindow = window;
-    std::cout << "Ventana del Working Set configurada a " << window << " accesos\n";
-}
\ No newline at end of file
+    if (verbose) std::cout << "Ventana del Working Set configurada a " << window << " accesos\n";
+}
+
+// Cada hilo es un CPU que ejecuta su propio proceso: la mayoría de accesos caen
+// en su conjunto de trabajo (hits sin lock) y el resto en páginas frías que
+// provocan fallos y reemplazos LRU concurrentes
+void MemoryManager::runScalingBenchmark(int maxThreads, long long accessesPerThread) {
+    if (maxThreads < 1) maxThreads = 1;
+    const int hotPages = 256;
+    const int coldPages = 4096;
+    const int frames = hotPages * maxThreads * 2;
+    const size_t batch = 4096;
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "\n--- BENCHMARK DE CONCURRENCIA (LRU) ---\n";
+    std::cout << "Núcleos disponibles: " << std::thread::hardware_concurrency() << " | Marcos: " << frames
+              << " | Accesos por hilo: " << accessesPerThread << "\n";
+
+    double baseline = 0.0;
+    for (int threads : threadCounts) {
+        MemoryManager memory(frames);
+        memory.replacementPolicy = PageReplacement::LRU;
+
+        // Trazas deterministas: 98% conjunto de trabajo, 2% páginas frías, 1/128 escrituras
+        std::vector<std::vector<PageRef>> traces(threads);
+        for (int t = 0; t < threads; ++t) {
+            uint64_t state = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(t + 1);
+            traces[t].reserve(static_cast<size_t>(accessesPerThread));
+            for (long long i = 0; i < accessesPerThread; ++i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                uint32_t r = static_cast<uint32_t>(state >> 33);
+                int page = (r % 100 < 2) ? hotPages + static_cast<int>((r >> 8) % coldPages)
+                                         : static_cast<int>((r >> 8) % hotPages);
+                traces[t].push_back(PageRef{t + 1, page, (r & 0x7f) == 0});
+            }
+        }
+
+        std::vector<AccessResult> results(threads, AccessResult{0, 0});
+        std::vector<std::thread> workers;
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&memory, &traces, &results, t, batch]() {
+                const std::vector<PageRef> &refs = traces[t];
+                for (size_t offset = 0; offset < refs.size(); offset += batch) {
+                    size_t count = std::min(batch, refs.size() - offset);
+                    AccessResult partial = memory.accessPages(refs.data() + offset, count, nullptr, t);
+                    results[t].hits += partial.hits;
+                    results[t].faults += partial.faults;
+                }
+            });
+        }
+        for (std::thread &worker : workers) worker.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long long hits = 0;
+        long long faults = 0;
+        for (const AccessResult &result : results) {
+            hits += result.hits;
+            faults += result.faults;
+        }
+        double hitRate = seconds > 0 ? hits / seconds / 1e6 : 0.0;
+        if (threads == 1) baseline = hitRate;
+        std::cout << "Hilos " << threads << ": " << hitRate << " M hits/s | "
+                  << (seconds > 0 ? faults / seconds / 1e3 : 0.0) << " K fallos/s | "
+                  << "aceleración x" << (baseline > 0 ? hitRate / baseline : 0.0) << "\n";
+    }
+}
@@ -1,21 +1,172 @@
 //process_manager.cpp
 #include "process_manager.h"
+#include <deque>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <numeric>
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include "run_queue_ring.h"
+#include "snapshot.h"
+#include "workload_generator.h"
+#include <type_traits>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 ProcessManager::ProcessManager(MemoryManager *mm) 
-    : memoryManager(mm), schedulerType(SchedulerType::RR), timeQuantum(2), 
-      schedulerRunning(false), autoExecute(false) {
+    : readySeq(0), memoryManager(mm), schedulerType(SchedulerType::RR), timeQuantum(2), adaptivePercentile(0),
+      contextSwitchCost(0), schedulerRunning(false), autoExecute(false), virtualTime(0), pacingMs(0),
+      schedulerStats{0, 0, 0.0, 0.0, 0.0, 0.0}, readyPending(false),
+      mlfqQuanta{2, 4, 8, 16}, mlfqMask(0), boostInterval(50), lastBoost(0), cfsTargetLatency(20), cfsMinGranularity(2),
+      cfsMinVruntime(0), cfsReadyWeight(0), rtPolicy(RealTimePolicy::EDF), rtAdmission(true), lastSummary{}, migrationCost(1),
+      devices(nullptr), ioSeq(0), pageInDelay(5), localityPercent(90) {
     // NO iniciar el planificador automáticamente
 }
 
+// Pesos de Linux para nice -10, -5, 0 y 5: cada prioridad recibe unas 3 veces la CPU
+// de la siguiente
+const int ProcessManager::cfsWeights[4] = {9548, 3121, 1024, 335};
+
 ProcessManager::~ProcessManager() {
+    if (devices != nullptr) devices->setInterruptHandler(InterruptType::IO_COMPLETE, nullptr);
     stopScheduler();
 }
 
+static const char* schedulerName(SchedulerType type) {
+    switch (type) {
+        case SchedulerType::RR: return "Round Robin";
+        case SchedulerType::SJF: return "SJF";
+        case SchedulerType::MLFQ: return "MLFQ";
+        case SchedulerType::SRTF: return "SRTF";
+        case SchedulerType::CFS: return "CFS";
+    }
+    return "?";
+}
+
+void QuantumTuner::reset(int initialQuantum, int targetPercentile) {
+    count = 0;
+    oldest = 0;
+    percentile = std::min(100, std::max(1, targetPercentile));
+    quantum = std::min(MAX_QUANTUM, std::max(1, initialQuantum));
+    turns = 0;
+    retunes = 0;
+}
+
+void QuantumTuner::observe(int remaining) {
+    if (remaining <= 0) return;
+    if (count < WINDOW) {
+        samples[count++] = remaining;
+    } else {
+        samples[oldest] = remaining;
+        oldest = (oldest + 1) % WINDOW;
+    }
+}
+
+// Hasta tener la ventana llena se usa el quantum inicial
+int QuantumTuner::next() {
+    if (++turns < RETUNE_EVERY || count < WINDOW) return quantum;
+    turns = 0;
+    int sorted[WINDOW];
+    std::copy(samples, samples + WINDOW, sorted);
+    int rank = (WINDOW - 1) * percentile / 100;
+    std::nth_element(sorted, sorted + rank, sorted + WINDOW);
+    int tuned = std::min(MAX_QUANTUM, sorted[rank]);
+    if (tuned != quantum) {
+        quantum = tuned;
+        retunes++;
+    }
+    return quantum;
+}
+
+long long QuantumTuner::getRetunes() const {
+    return retunes;
+}
+
 int ProcessManager::findIndexByPid(int pid) const {
-    for (size_t i = 0; i < processes.size(); ++i)
-        if (processes[i].pid == pid)
-            return static_cast<int>(i);
-    return -1;
+    auto it = pidIndex.find(pid);
+    return it == pidIndex.end() ? -1 : it->second;
+}
+
+// Ocupa la última ranura liberada (sigue caliente en caché) o una nueva al final
+int ProcessManager::allocSlot(const Process& p) {
+    int idx;
+    if (!freeSlots.empty()) {
+        idx = freeSlots.back();
+        freeSlots.pop_back();
+        processes[idx] = p;
+    } else {
+        idx = static_cast<int>(processes.size());
+        processes.push_back(p);
+        readyList.reserve(processes.size());
+        for (ReadyList &level : mlfqReady) level.reserve(processes.size());
+    }
+    pidIndex[p.pid] = idx;
+    return idx;
+}
+
+void ProcessManager::freeSlot(int idx) {
+    pidIndex.erase(processes[idx].pid);
+    processes[idx].pid = -1;
+    processes[idx].state = ProcessState::Terminado;
+    processes[idx].remainingTime = 0;
+    freeSlots.push_back(idx);
+}
+
+// Encola en la cola de listos y en la de su nivel MLFQ; con SJF, también en el
+// montículo. Con CFS entra en el árbol; quien llega o despierta empieza como mínimo
+// en el menor vruntime, para que no acapare la CPU por haber estado fuera
+void ProcessManager::pushReady(int pid) {
+    int idx = findIndexByPid(pid);
+    if (idx == -1 || !readyList.pushBack(idx)) return;
+    int level = processes[idx].level;
+    mlfqReady[level].pushBack(idx);
+    mlfqMask |= 1u << level;
+    cfsReadyWeight += cfsWeights[processes[idx].priority];
+    if (schedulerType == SchedulerType::RR && adaptivePercentile > 0) {
+        rrTuner.observe(processes[idx].remainingTime);
+    } else if (schedulerType == SchedulerType::SJF || schedulerType == SchedulerType::SRTF) {
+        sjfHeap.push(ReadyEntry{processes[idx].remainingTime, readySeq++, pid});
+    } else if (schedulerType == SchedulerType::CFS) {
+        processes[idx].vruntime = std::max(processes[idx].vruntime, cfsMinVruntime);
+        cfsTree.insert(CfsEntry{processes[idx].vruntime, readySeq++, pid});
+    }
+}
+
+// Quita la ranura de la cola de listos en O(1); no hace nada si no estaba
+void ProcessManager::removeReady(int idx) {
+    if (!readyList.remove(idx)) return;
+    int level = processes[idx].level;
+    mlfqReady[level].remove(idx);
+    if (mlfqReady[level].empty()) mlfqMask &= ~(1u << level);
+    cfsReadyWeight -= cfsWeights[processes[idx].priority];
+}
+
+// Vacía la cola de listos y las de cada nivel
+void ProcessManager::clearReady() {
+    readyList.clear();
+    for (ReadyList &level : mlfqReady) level.clear();
+    mlfqMask = 0;
+    cfsReadyWeight = 0;
+}
+
+// Al pasar a SJF el montículo se rehace con la cola de listos actual
+void ProcessManager::rebuildSjfHeap() {
+    sjfHeap = std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>>();
+    for (int idx = readyList.front(); idx != ReadyList::NONE; idx = readyList.next(idx)) {
+        sjfHeap.push(ReadyEntry{processes[idx].remainingTime, readySeq++, processes[idx].pid});
+    }
+}
+
+void ProcessManager::rebuildCfsTree() {
+    cfsTree.clear();
+    for (int idx = readyList.front(); idx != ReadyList::NONE; idx = readyList.next(idx)) {
+        processes[idx].vruntime = std::max(processes[idx].vruntime, cfsMinVruntime);
+        cfsTree.insert(CfsEntry{processes[idx].vruntime, readySeq++, processes[idx].pid});
+    }
 }
 
 bool ProcessManager::createProcess(int pid, int burstTime, int arrivalTime, int priority, int memoryRequired) {
@@ -31,14 +182,18 @@ bool ProcessManager::createProcess(int pid, int burstTime, int arrivalTime, int
         return false;
     }
 
+    // El proceso se ubica en el nodo NUMA con más marcos libres
+    int homeNode = memoryManager->leastLoadedNode();
+    memoryManager->setHomeNode(pid, homeNode);
     if (!memoryManager->allocate(memoryRequired, pid)) {
+        memoryManager->setHomeNode(pid, -1);
         std::cout << "No se pudo asignar memoria para el proceso.\n";
         return false;
     }
 
     Process p{pid, burstTime, arrivalTime, priority, memoryRequired, 
-              ProcessState::Nuevo, burstTime, 0};
-    processes.push_back(p);
+              ProcessState::Nuevo, burstTime, 0, homeNode, priority, -1, 0, 0, 0};
+    allocSlot(p);
     
     // Dejar el proceso en estado Nuevo, NO agregarlo a la cola de listos automáticamente
     std::cout << "Proceso " << pid << " creado exitosamente.\n";
@@ -46,111 +201,300 @@ bool ProcessManager::createProcess(int pid, int burstTime, int arrivalTime, int
     return true;
 }
 
-void ProcessManager::scheduleRR() {
-    if (readyQueue.empty()) return;
+// El hijo copia los datos del padre y comparte su memoria con copy-on-write
+bool ProcessManager::forkProcess(int parentPid, int childPid) {
+    std::lock_guard<std::mutex> lock(mtx);
 
-    int pid = readyQueue.front();
-    readyQueue.pop();
-    
-    int idx = findIndexByPid(pid);
-    if (idx == -1) return;
+    int parentIdx = findIndexByPid(parentPid);
+    if (parentIdx == -1) {
+        std::cout << "No existe el proceso padre " << parentPid << ".\n";
+        return false;
+    }
+    if (findIndexByPid(childPid) != -1) {
+        std::cout << "Ya existe un proceso con ID " << childPid << ".\n";
+        return false;
+    }
+    if (!memoryManager->fork(parentPid, childPid)) {
+        std::cout << "No se pudo compartir la memoria del proceso padre.\n";
+        return false;
+    }
+
+    Process child = processes[parentIdx];
+    child.pid = childPid;
+    child.state = ProcessState::Nuevo;
+    child.remainingTime = child.burstTime;
+    child.waitTime = 0;
+    allocSlot(child);
 
+    std::cout << "Proceso " << childPid << " creado con fork desde el proceso " << parentPid << ".\n";
+    return true;
+}
+
+// En la cola solo hay procesos listos con tiempo restante: suspender, terminar y
+// despachar con otra política los sacan al momento
+void ProcessManager::scheduleRR(std::unique_lock<std::mutex>& lock) {
+    if (readyList.empty()) return;
+
+    int idx = readyList.front();
+    removeReady(idx);
     Process &p = processes[idx];
-    
-    // No ejecutar procesos suspendidos o terminados
-    if (p.state == ProcessState::Suspendido || p.state == ProcessState::Terminado) {
-        return;
-    }
+    int pid = p.pid;
     
     p.state = ProcessState::Ejecutando;
     
-    std::cout << "⏰ EJECUTANDO RR - Proceso " << pid << " (Quantum: " << timeQuantum << ")\n" << std::flush;
-    
-    int executionTime = std::min(timeQuantum, p.remainingTime);
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    int quantum = adaptivePercentile > 0 ? rrTuner.next() : timeQuantum;
+    std::cout << "⏰ EJECUTANDO RR - Proceso " << pid << " (Quantum: " << quantum << ") | t=" << virtualTime << "\n" << std::flush;
     
-    p.remainingTime -= executionTime;
+    int executionTime = ioLimit(p, std::min(quantum, p.remainingTime));
+    advanceClock(lock, executionTime);
+
+    // Con ritmo de demostración el turno corre sin el cerrojo: el proceso pudo ser
+    // suspendido o terminado (y su ranura reutilizada), y el vector pudo crecer
+    idx = findIndexByPid(pid);
+    if (idx == -1 || (processes[idx].state != ProcessState::Ejecutando &&
+                      processes[idx].state != ProcessState::Suspendido)) return;
+    Process &ran = processes[idx];
+    ran.remainingTime -= executionTime;
+    ran.cpuSinceIo += executionTime;
+    if (ran.state == ProcessState::Suspendido || issueIO(idx)) return;
     
-    if (p.remainingTime > 0) {
-        p.state = ProcessState::Listo;
-        readyQueue.push(pid);
-        std::cout << "↩️  Proceso " << pid << " vuelve a cola (Restante: " << p.remainingTime << ")\n" << std::flush;
+    if (ran.remainingTime > 0) {
+        ran.state = ProcessState::Listo;
+        pushReady(pid);
+        std::cout << "↩️  Proceso " << pid << " vuelve a cola (Restante: " << ran.remainingTime << ")\n" << std::flush;
     } else {
-        p.state = ProcessState::Listo;
+        ran.state = ProcessState::Listo;
         std::cout << "✅ Proceso " << pid << " completó su ejecución (Restante: 0)\n" << std::flush;
         std::cout << "💡 Use la opción 7 para terminar formalmente el proceso.\n" << std::flush;
     }
 }
 
-void ProcessManager::scheduleSJF() {
-    if (readyQueue.empty()) return;
-
-    std::vector<int> readyPids;
-    std::queue<int> tempQueue = readyQueue;
-    
-    while (!tempQueue.empty()) {
-        readyPids.push_back(tempQueue.front());
-        tempQueue.pop();
-    }
-
+// SJF interactivo: el montículo da el más corto en O(log n). El borrado es perezoso:
+// una entrada vale si su proceso sigue listo con el mismo tiempo restante. El
+// despachado sale también de la cola de listos
+void ProcessManager::scheduleSJF(std::unique_lock<std::mutex>& lock) {
     int shortestIdx = -1;
-    int shortestTime = 9999;
-    
-    for (int pid : readyPids) {
-        int idx = findIndexByPid(pid);
-        if (idx != -1 && processes[idx].state == ProcessState::Listo && processes[idx].remainingTime < shortestTime) {
-            shortestTime = processes[idx].remainingTime;
+    while (!sjfHeap.empty() && shortestIdx == -1) {
+        ReadyEntry entry = sjfHeap.top();
+        sjfHeap.pop();
+        int idx = findIndexByPid(entry.id);
+        if (idx != -1 && processes[idx].state == ProcessState::Listo && processes[idx].remainingTime > 0 &&
+            processes[idx].remainingTime == entry.remaining) {
             shortestIdx = idx;
         }
     }
 
     if (shortestIdx == -1) return;
+    removeReady(shortestIdx);
 
     Process &p = processes[shortestIdx];
     p.state = ProcessState::Ejecutando;
     
-    std::cout << "⏰ EJECUTANDO SJF - Proceso " << p.pid << " (Tiempo: " << p.remainingTime << ")\n" << std::flush;
+    std::cout << "⏰ EJECUTANDO SJF - Proceso " << p.pid << " (Tiempo: " << p.remainingTime << ") | t=" << virtualTime << "\n" << std::flush;
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(800));
-    
-    p.remainingTime = 0;
-    p.state = ProcessState::Listo;
+    int pid = p.pid;
+    int executionTime = ioLimit(p, p.remainingTime);
+    advanceClock(lock, executionTime);
+
+    // Mientras corría sin el cerrojo pudieron terminarlo, o suspenderlo: entonces
+    // la ráfaga no cuenta y se repite al reanudarlo
+    int idx = findIndexByPid(pid);
+    if (idx == -1 || processes[idx].state != ProcessState::Ejecutando) return;
+    processes[idx].remainingTime -= executionTime;
+    processes[idx].cpuSinceIo += executionTime;
+    if (issueIO(idx)) return;
+    processes[idx].state = ProcessState::Listo;
     
-    std::cout << "✅ Proceso " << p.pid << " completó su ejecución (SJF)\n" << std::flush;
+    std::cout << "✅ Proceso " << pid << " completó su ejecución (SJF)\n" << std::flush;
     std::cout << "💡 Use la opción 7 para terminar formalmente el proceso.\n" << std::flush;
-    
-    std::queue<int> newQueue;
-    for (int pid : readyPids) {
-        if (pid != p.pid) {
-            newQueue.push(pid);
+}
+
+// MLFQ interactivo: corre el primero de la cola del nivel más alto con listos, que
+// da en O(1) el bit más bajo de mlfqMask
+void ProcessManager::scheduleMLFQ(std::unique_lock<std::mutex>& lock) {
+    if (mlfqMask == 0) return;
+
+    // Impulso periódico: los listos de cada nivel pasan, en orden, al final del
+    // nivel 0 para que nadie muera de inanición
+    if (boostInterval > 0 && virtualTime - lastBoost >= boostInterval) {
+        for (int level = 1; level < MLFQ_LEVELS; ++level) {
+            for (int idx = mlfqReady[level].popFront(); idx != ReadyList::NONE; idx = mlfqReady[level].popFront()) {
+                processes[idx].level = 0;
+                mlfqReady[0].pushBack(idx);
+            }
+        }
+        mlfqMask = 1u;
+        lastBoost = virtualTime;
+        std::cout << "🚀 Impulso de prioridad: todos los procesos listos al nivel 0\n" << std::flush;
+    }
+
+    int chosenIdx = mlfqReady[__builtin_ctz(mlfqMask)].front();
+    removeReady(chosenIdx);
+
+    Process &p = processes[chosenIdx];
+    p.state = ProcessState::Ejecutando;
+    int quantum = levelQuantum(p);
+    std::cout << "⏰ EJECUTANDO MLFQ - Proceso " << p.pid << " (Nivel: " << p.level << ", Quantum: " << quantum
+              << ") | t=" << virtualTime << "\n" << std::flush;
+
+    int pid = p.pid;
+    int executionTime = ioLimit(p, std::min(quantum, p.remainingTime));
+    advanceClock(lock, executionTime);
+
+    // Mientras corría sin el cerrojo pudieron suspenderlo o terminarlo
+    chosenIdx = findIndexByPid(pid);
+    if (chosenIdx == -1 || (processes[chosenIdx].state != ProcessState::Ejecutando &&
+                            processes[chosenIdx].state != ProcessState::Suspendido)) return;
+    Process &ran = processes[chosenIdx];
+    ran.remainingTime -= executionTime;
+    ran.cpuSinceIo += executionTime;
+    // Si se bloquea por E/S antes de agotar el quantum conserva su nivel
+    if (ran.state == ProcessState::Suspendido || issueIO(chosenIdx)) return;
+
+    ran.state = ProcessState::Listo;
+    if (ran.remainingTime > 0) {
+        // Agotó el quantum: baja un nivel
+        if (ran.level < MLFQ_LEVELS - 1) ran.level++;
+        pushReady(pid);
+        std::cout << "↩️  Proceso " << pid << " vuelve a cola (Restante: " << ran.remainingTime
+                  << ", nivel " << ran.level << ")\n" << std::flush;
+    } else {
+        std::cout << "✅ Proceso " << pid << " completó su ejecución (Restante: 0)\n" << std::flush;
+        std::cout << "💡 Use la opción 7 para terminar formalmente el proceso.\n" << std::flush;
+    }
+}
+
+// Turno de CFS: la parte de la latencia objetivo que le toca por su peso, nunca
+// menos que la granularidad mínima
+int ProcessManager::cfsSlice(int targetLatency, int minGranularity, int weight, long long totalWeight) {
+    long long slice = totalWeight > 0 ? targetLatency * static_cast<long long>(weight) / totalWeight : targetLatency;
+    return static_cast<int>(std::max<long long>(minGranularity, slice));
+}
+
+// vruntime que suma ejecutar "units" con ese peso: con peso de nice 0 avanza al
+// ritmo real; más peso, más lento
+static long long cfsDelta(int units, int weight) {
+    return static_cast<long long>(units) * 1024 * 1024 / weight;
+}
+
+// CFS interactivo: corre el de menor vruntime del árbol. Como en SJF, una entrada
+// vale si su proceso sigue listo con el mismo vruntime
+void ProcessManager::scheduleCFS(std::unique_lock<std::mutex>& lock) {
+    int chosenIdx = -1;
+    while (!cfsTree.empty() && chosenIdx == -1) {
+        CfsEntry entry = *cfsTree.begin();
+        cfsTree.erase(cfsTree.begin());
+        int idx = findIndexByPid(entry.id);
+        if (idx != -1 && processes[idx].state == ProcessState::Listo && processes[idx].remainingTime > 0 &&
+            processes[idx].vruntime == entry.vruntime) {
+            chosenIdx = idx;
         }
     }
-    readyQueue = newQueue;
+    if (chosenIdx == -1) return;
+
+    // Se saca de la cola de listos; el peso de los que siguen esperando ya está sumado
+    int pid = processes[chosenIdx].pid;
+    int weight = cfsWeights[processes[chosenIdx].priority];
+    removeReady(chosenIdx);
+    long long totalWeight = weight + cfsReadyWeight;
+
+    Process &p = processes[chosenIdx];
+    p.state = ProcessState::Ejecutando;
+    int slice = cfsSlice(cfsTargetLatency, cfsMinGranularity, weight, totalWeight);
+    std::cout << "⏰ EJECUTANDO CFS - Proceso " << pid << " (vruntime: " << p.vruntime / 1024 << ", Turno: " << slice
+              << ") | t=" << virtualTime << "\n" << std::flush;
+
+    int executionTime = ioLimit(p, std::min(slice, p.remainingTime));
+    advanceClock(lock, executionTime);
+
+    // Mientras corría sin el cerrojo pudieron suspenderlo o terminarlo
+    chosenIdx = findIndexByPid(pid);
+    if (chosenIdx == -1 || (processes[chosenIdx].state != ProcessState::Ejecutando &&
+                            processes[chosenIdx].state != ProcessState::Suspendido)) return;
+    Process &ran = processes[chosenIdx];
+    ran.remainingTime -= executionTime;
+    ran.vruntime += cfsDelta(executionTime, weight);
+    long long lowest = cfsTree.empty() ? ran.vruntime : std::min(ran.vruntime, cfsTree.begin()->vruntime);
+    cfsMinVruntime = std::max(cfsMinVruntime, lowest);
+    ran.cpuSinceIo += executionTime;
+    if (ran.state == ProcessState::Suspendido || issueIO(chosenIdx)) return;
+
+    ran.state = ProcessState::Listo;
+    if (ran.remainingTime > 0) {
+        pushReady(pid);
+        std::cout << "↩️  Proceso " << pid << " vuelve al árbol (Restante: " << ran.remainingTime << ", vruntime: "
+                  << ran.vruntime / 1024 << ")\n" << std::flush;
+    } else {
+        std::cout << "✅ Proceso " << pid << " completó su ejecución (Restante: 0)\n" << std::flush;
+        std::cout << "💡 Use la opción 7 para terminar formalmente el proceso.\n" << std::flush;
+    }
+}
+
+void ProcessManager::dispatch(std::unique_lock<std::mutex>& lock) {
+    switch (schedulerType) {
+        case SchedulerType::RR:
+            scheduleRR(lock);
+            break;
+        case SchedulerType::SJF:
+        case SchedulerType::SRTF:   // Sin llegadas que expulsar, es SJF
+            scheduleSJF(lock);
+            break;
+        case SchedulerType::MLFQ:
+            scheduleMLFQ(lock);
+            break;
+        case SchedulerType::CFS:
+            scheduleCFS(lock);
+            break;
+    }
+}
+
+// SJF despacha desde el montículo; el resto, desde la cola de listos. Las entradas
+// perezosas se consumen al despachar, así que el planificador no queda girando
+bool ProcessManager::hasReadyWork() const {
+    if (schedulerType == SchedulerType::SJF || schedulerType == SchedulerType::SRTF) return !sjfHeap.empty();
+    if (schedulerType == SchedulerType::CFS) return !cfsTree.empty();
+    return !readyList.empty();
+}
+
+// Llamar con mtx tomado: despierta al planificador y anota desde cuándo espera
+void ProcessManager::notifyReady() {
+    if (!readyPending) {
+        readyPending = true;
+        readySince = std::chrono::steady_clock::now();
+    }
+    cv.notify_one();
+}
+
+void ProcessManager::recordHold() {
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - lockedSince).count();
+    schedulerStats.totalHoldUs += us;
+    schedulerStats.maxHoldUs = std::max(schedulerStats.maxHoldUs, us);
 }
 
+// Duerme en la variable de condición hasta que haya procesos listos con la
+// ejecución automática activa, o hasta que se detenga el planificador
 void ProcessManager::schedulerLoop() {
-    while (schedulerRunning) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-        
-        if (!autoExecute) continue; // No ejecutar si autoExecute está desactivado
-        
-        std::lock_guard<std::mutex> lock(mtx);
-        
-        if (!readyQueue.empty()) {
-            switch (schedulerType) {
-                case SchedulerType::RR:
-                    scheduleRR();
-                    break;
-                case SchedulerType::SJF:
-                    scheduleSJF();
-                    break;
-            }
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+        cv.wait(lock, [this] { return !schedulerRunning || (autoExecute && hasReadyWork()); });
+        if (!schedulerRunning) break;
+
+        lockedSince = std::chrono::steady_clock::now();
+        if (readyPending) {
+            double us = std::chrono::duration<double, std::micro>(lockedSince - readySince).count();
+            schedulerStats.wakeups++;
+            schedulerStats.totalLatencyUs += us;
+            schedulerStats.maxLatencyUs = std::max(schedulerStats.maxLatencyUs, us);
+            readyPending = false;
         }
+        schedulerStats.dispatches++;
+        dispatch(lock);
+        recordHold();
     }
 }
 
 bool ProcessManager::executeProcess(int pid) {
-    std::lock_guard<std::mutex> lock(mtx);
+    std::unique_lock<std::mutex> lock(mtx);
     int idx = findIndexByPid(pid);
     if (idx == -1) {
         std::cout << "No existe el proceso con ID " << pid << ".\n";
@@ -165,24 +509,22 @@ bool ProcessManager::executeProcess(int pid) {
 
     if (p.state == ProcessState::Nuevo || p.state == ProcessState::Suspendido) {
         p.state = ProcessState::Listo;
-        readyQueue.push(pid);
+        pushReady(pid);
         std::cout << "Proceso " << pid << " agregado a cola de listos.\n";
         
-        // Ejecutar inmediatamente si el planificador automático está desactivado
-        if (!autoExecute) {
-            mtx.unlock();
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            mtx.lock();
-            
-            // Ejecutar manualmente
-            if (schedulerType == SchedulerType::RR) {
-                scheduleRR();
-            } else {
-                scheduleSJF();
-            }
+        // Con ejecución automática lo despacha el planificador; si no, se ejecuta ya
+        if (autoExecute) {
+            notifyReady();
+        } else {
+            lockedSince = std::chrono::steady_clock::now();
+            schedulerStats.dispatches++;
+            dispatch(lock);
+            recordHold();
         }
     } else {
-        std::cout << "El proceso ya está en estado: " << (p.state == ProcessState::Listo ? "Listo" : "Ejecutando") << "\n";
+        std::cout << "El proceso ya está en estado: "
+                  << (p.state == ProcessState::Listo ? "Listo" : p.state == ProcessState::Bloqueado ? "Bloqueado" : "Ejecutando")
+                  << "\n";
     }
     
     return true;
@@ -204,15 +546,7 @@ bool ProcessManager::suspendProcess(int pid) {
     processes[idx].state = ProcessState::Suspendido;
     
     // Remover de la cola de listos si está ahí
-    std::queue<int> newQueue;
-    while (!readyQueue.empty()) {
-        int currentPid = readyQueue.front();
-        readyQueue.pop();
-        if (currentPid != pid) {
-            newQueue.push(currentPid);
-        }
-    }
-    readyQueue = newQueue;
+    removeReady(idx);
     
     std::cout << "Proceso " << pid << " suspendido.\n";
     return true;
@@ -231,8 +565,14 @@ bool ProcessManager::resumeProcess(int pid) {
         return false;
     }
 
+    if (pendingIO.count(pid)) {
+        processes[idx].state = ProcessState::Bloqueado;
+        std::cout << "Proceso " << pid << " reanudado; sigue bloqueado esperando su E/S.\n";
+        return true;
+    }
     processes[idx].state = ProcessState::Listo;
-    readyQueue.push(pid);
+    pushReady(pid);
+    notifyReady();
     std::cout << "Proceso " << pid << " reanudado y en cola de listos.\n";
     return true;
 }
@@ -250,19 +590,10 @@ bool ProcessManager::terminateProcess(int pid) {
         return false;
     }
 
-    processes[idx].state = ProcessState::Terminado;
-    processes[idx].remainingTime = 0;
     memoryManager->freeProcessPages(pid);
-    
-    std::queue<int> newQueue;
-    while (!readyQueue.empty()) {
-        int currentPid = readyQueue.front();
-        readyQueue.pop();
-        if (currentPid != pid) {
-            newQueue.push(currentPid);
-        }
-    }
-    readyQueue = newQueue;
+    removeReady(idx);
+    pendingIO.erase(pid);
+    freeSlot(idx);
     
     std::cout << "Proceso " << pid << " terminado.\n";
     return true;
@@ -272,18 +603,20 @@ void ProcessManager::listProcesses() const {
     std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mtx));
     
     std::cout << "\n--- Lista de Procesos ---\n";
-    if (processes.empty()) {
+    if (pidIndex.empty()) {
         std::cout << "(Sin procesos creados)\n";
         return;
     }
 
     for (const auto &p : processes) {
+        if (p.pid == -1) continue;   // Ranura libre del pool
         std::string estado;
         switch (p.state) {
             case ProcessState::Nuevo: estado = "Nuevo"; break;
             case ProcessState::Listo: estado = "Listo"; break;
             case ProcessState::Ejecutando: estado = "Ejecutando"; break;
             case ProcessState::Suspendido: estado = "Suspendido"; break;
+            case ProcessState::Bloqueado: estado = "Bloqueado"; break;
             case ProcessState::Terminado: estado = "Terminado"; break;
         }
         
@@ -293,29 +626,72 @@ void ProcessManager::listProcesses() const {
                   << " | Llegada: " << p.arrivalTime
                   << " | Prioridad: " << p.priority
                   << " | Memoria: " << p.memoryRequired
-                  << " | Estado: " << estado << "\n";
+                  << " | Espera: " << p.waitTime;
+        if (memoryManager->getNodeCount() > 1) std::cout << " | Nodo: " << p.homeNode;
+        if (p.deadline > 0) std::cout << " | Periodo: " << p.period << " | Plazo: " << p.deadline;
+        if (p.ioInterval > 0) std::cout << " | E/S: cada " << p.ioInterval << " (" << p.ioDuration << " u)";
+        if (p.pageSpan > 0) std::cout << " | Páginas: " << p.pageSpan << " (conjunto " << p.workingSet << ")";
+        std::cout << " | Estado: " << estado << "\n";
     }
     
     std::cout << "Cola de listos: ";
-    std::queue<int> temp = readyQueue;
-    if (temp.empty()) {
-        std::cout << "(vacía)";
-    }
-    while (!temp.empty()) {
-        std::cout << temp.front() << " ";
-        temp.pop();
+    for (int idx = readyList.front(); idx != ReadyList::NONE; idx = readyList.next(idx)) {
+        std::cout << processes[idx].pid << " ";
     }
+    if (readyList.empty()) std::cout << "(vacía)";
     std::cout << "\n";
+    std::cout << "Pool de procesos: " << pidIndex.size() << " vivos | " << freeSlots.size() << " ranuras libres\n";
 }
 
-void ProcessManager::setScheduler(SchedulerType type, int quantum) {
+void ProcessManager::setScheduler(SchedulerType type, int quantum, bool verbose) {
     std::lock_guard<std::mutex> lock(mtx);
     schedulerType = type;
     timeQuantum = quantum;
-    std::cout << "Planificador cambiado a " << (type == SchedulerType::RR ? "Round Robin" : "SJF") << "\n";
+    // MLFQ: el quantum se duplica en cada nivel
+    for (int level = 0; level < MLFQ_LEVELS; ++level) mlfqQuanta[level] = quantum << level;
+    rrTuner.reset(quantum, adaptivePercentile);
+    if (type == SchedulerType::SJF || type == SchedulerType::SRTF) rebuildSjfHeap();
+    if (type == SchedulerType::CFS) rebuildCfsTree();
+    cv.notify_all();
+    if (!verbose) return;
+    std::cout << "Planificador cambiado a " << schedulerName(type) << "\n";
+    if (type == SchedulerType::MLFQ) {
+        std::cout << "Quantum por nivel: " << mlfqQuanta[0] << "/" << mlfqQuanta[1] << "/" << mlfqQuanta[2] << "/"
+                  << mlfqQuanta[3] << " | Impulso de prioridad cada " << boostInterval << " unidades\n";
+    }
+    if (type == SchedulerType::CFS) {
+        std::cout << "Latencia objetivo: " << cfsTargetLatency << " | Granularidad mínima: " << cfsMinGranularity
+                  << "\n";
+    }
+    if (type == SchedulerType::RR && adaptivePercentile > 0) {
+        std::cout << "Quantum adaptativo: percentil " << adaptivePercentile << " de las ráfagas restantes (inicial "
+                  << quantum << ")\n";
+    }
+}
+
+// 0 vuelve al quantum fijo; el percentil solo se usa con Round Robin
+void ProcessManager::setAdaptiveQuantum(int percentile, bool verbose) {
+    std::lock_guard<std::mutex> lock(mtx);
+    adaptivePercentile = std::min(100, std::max(0, percentile));
+    rrTuner.reset(timeQuantum, adaptivePercentile);
+    if (!verbose) return;
+    if (adaptivePercentile == 0) {
+        std::cout << "Quantum fijo: " << timeQuantum << "\n";
+    } else {
+        std::cout << "Quantum adaptativo: percentil " << adaptivePercentile << " de los últimos "
+                  << QuantumTuner::WINDOW << " tiempos restantes, reajustado cada " << QuantumTuner::RETUNE_EVERY
+                  << " turnos (1-" << QuantumTuner::MAX_QUANTUM << ")\n";
+    }
+}
+
+void ProcessManager::setContextSwitchCost(int units, bool verbose) {
+    std::lock_guard<std::mutex> lock(mtx);
+    contextSwitchCost = std::max(0, units);
+    if (verbose) std::cout << "🔁 Coste de cada cambio de contexto: " << contextSwitchCost << " unidades\n";
 }
 
 void ProcessManager::startScheduler() {
+    std::lock_guard<std::mutex> lock(mtx);
     if (schedulerRunning) {
         std::cout << "⚠️  El planificador ya está en ejecución.\n";
         return;
@@ -328,9 +704,12 @@ void ProcessManager::startScheduler() {
 }
 
 void ProcessManager::stopScheduler() {
-    if (!schedulerRunning) return;
-    
-    schedulerRunning = false;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!schedulerRunning) return;
+        schedulerRunning = false;
+    }
+    cv.notify_all();
     if (schedulerThread.joinable()) {
         schedulerThread.join();
     }
@@ -340,10 +719,1965 @@ void ProcessManager::stopScheduler() {
 void ProcessManager::setAutoExecute(bool enable) {
     std::lock_guard<std::mutex> lock(mtx);
     autoExecute = enable;
+    cv.notify_all();
     std::cout << "Ejecución automática de procesos: " << (enable ? "ACTIVADA" : "DESACTIVADA") << "\n";
     if (enable) {
         std::cout << "⚠️  Los procesos en cola de listos se ejecutarán automáticamente.\n";
     } else {
         std::cout << "💡 Use las opciones del menú para ejecutar procesos manualmente.\n";
     }
+}
+
+// ---------------- E/S ----------------
+
+// Las interrupciones IO_COMPLETE del DeviceManager despiertan a los procesos
+// bloqueados; las que no son de un proceso bloqueado siguen en la cola (el swap
+// termina con SWAP_OUT)
+void ProcessManager::attachDevices(DeviceManager* deviceManager) {
+    if (devices != nullptr) devices->setInterruptHandler(InterruptType::IO_COMPLETE, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        devices = deviceManager;
+    }
+    if (deviceManager != nullptr) {
+        deviceManager->setInterruptHandler(InterruptType::IO_COMPLETE,
+                                           [this](const Interrupt& irq) { return onIOComplete(irq); });
+    }
+}
+
+bool ProcessManager::setIOProfile(int pid, int interval, int duration) {
+    std::lock_guard<std::mutex> lock(mtx);
+    int idx = findIndexByPid(pid);
+    if (idx == -1) {
+        std::cout << "No existe el proceso con ID " << pid << ".\n";
+        return false;
+    }
+    if (interval < 0 || (interval > 0 && duration <= 0)) {
+        std::cout << "❌ Intervalo >= 0 y duración > 0.\n";
+        return false;
+    }
+    Process &p = processes[idx];
+    p.ioInterval = interval;
+    p.ioDuration = interval > 0 ? duration : 0;
+    p.cpuSinceIo = 0;
+    if (interval == 0) {
+        std::cout << "✅ Proceso " << pid << ": solo usa CPU\n";
+    } else {
+        std::cout << "✅ Proceso " << pid << ": E/S cada " << interval << " unidades de CPU, " << duration
+                  << " unidades en el disco\n";
+        if (p.deadline > 0) std::cout << "⚠️  Es de tiempo real: sus activaciones no hacen E/S.\n";
+    }
+    return true;
+}
+
+// Turno recortado hasta la próxima E/S, si llega antes de terminar la ráfaga
+int ProcessManager::ioLimit(const Process& p, int units) const {
+    if (devices == nullptr || p.ioInterval <= 0 || p.deadline > 0) return units;
+    int untilIo = std::max(1, p.ioInterval - p.cpuSinceIo);
+    return untilIo < p.remainingTime ? std::min(units, untilIo) : units;
+}
+
+// Llamar con mtx tomado tras un turno: si llegó a su punto de E/S, el proceso se
+// bloquea y la pide al disco (ioDuration unidades al ritmo de demostración)
+bool ProcessManager::issueIO(int idx) {
+    Process &p = processes[idx];
+    if (devices == nullptr || p.ioInterval <= 0 || p.deadline > 0 || p.remainingTime <= 0 ||
+        p.cpuSinceIo < p.ioInterval) {
+        return false;
+    }
+    p.cpuSinceIo = 0;
+    p.state = ProcessState::Bloqueado;
+    requestDeviceIO(p);
+    std::cout << "💤 Proceso " << p.pid << " bloqueado esperando E/S (" << p.ioDuration << " unidades, Restante: "
+              << p.remainingTime << ")\n" << std::flush;
+    return true;
+}
+
+// Con mtx tomado: la interrupción lleva un dato nuevo, así una entrega anterior
+// para el mismo pid no lo despierta
+void ProcessManager::requestDeviceIO(const Process& p) {
+    pendingIO[p.pid] = ++ioSeq;
+    IORequest request{p.pid, DeviceType::DISK_DRIVE, "E/S del proceso", p.priority, p.ioDuration * pacingMs};
+    request.completionData = ioSeq;
+    devices->submitIO(request);
+}
+
+// Hilo del dispositivo: entrega de IO_COMPLETE. Solo la acepta si es la E/S que
+// espera el proceso; si lo suspendieron mientras esperaba, sigue suspendido
+bool ProcessManager::onIOComplete(const Interrupt& irq) {
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = pendingIO.find(irq.processId);
+    if (it == pendingIO.end() || it->second != irq.data) return false;
+    pendingIO.erase(it);
+    int idx = findIndexByPid(irq.processId);
+    if (idx == -1 || processes[idx].state != ProcessState::Bloqueado) return true;
+    processes[idx].state = ProcessState::Listo;
+    pushReady(irq.processId);
+    notifyReady();
+    std::cout << "🔔 IO_COMPLETE: proceso " << irq.processId << " vuelve a la cola de listos\n" << std::flush;
+    return true;
+}
+
+// ---------------- Paginación por demanda ----------------
+
+bool ProcessManager::setMemoryPattern(int pid, int pageSpan, int workingSet) {
+    std::lock_guard<std::mutex> lock(mtx);
+    int idx = findIndexByPid(pid);
+    if (idx == -1) {
+        std::cout << "No existe el proceso con ID " << pid << ".\n";
+        return false;
+    }
+    if (pageSpan < 0 || (pageSpan > 0 && (workingSet <= 0 || workingSet > pageSpan))) {
+        std::cout << "❌ Páginas >= 0 y conjunto de trabajo entre 1 y el número de páginas.\n";
+        return false;
+    }
+    Process &p = processes[idx];
+    p.pageSpan = pageSpan;
+    p.workingSet = pageSpan > 0 ? workingSet : 0;
+    if (pageSpan == 0) {
+        std::cout << "✅ Proceso " << pid << ": no referencia memoria en la simulación\n";
+    } else {
+        std::cout << "✅ Proceso " << pid << ": " << PAGE_REFS_PER_UNIT << " referencias por unidad de CPU sobre "
+                  << pageSpan << " páginas, " << localityPercent << "% en las " << workingSet << " primeras\n";
+    }
+    return true;
+}
+
+void ProcessManager::setPagingParams(int delay, int locality, bool verbose) {
+    std::lock_guard<std::mutex> lock(mtx);
+    pageInDelay = std::max(1, delay);
+    localityPercent = std::min(100, std::max(0, locality));
+    if (verbose) std::cout << "✅ Lectura de página: " << pageInDelay << " unidades en el disco | Localidad: " << localityPercent
+              << "%\n";
+}
+
+// splitmix64: flujo de referencias reproducible e independiente por proceso
+static uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Reproduce las referencias de las unidades [cpuDone, cpuDone + units) que aún no se
+// reprodujeron (una expulsión puede dejar algunas hechas). Devuelve las unidades
+// completas antes del primer fallo, o -1 si no hubo. La unidad que falla cuenta como
+// reproducida: su página ya quedó cargada y al volver no se repite
+int ProcessManager::replayPages(MemoryManager& memory, Process& p, uint64_t& rng, int cpuDone, int units,
+                                int locality, long long& references) {
+    PageRef refs[PAGE_REFS_PER_UNIT];
+    int hot = std::max(1, std::min(p.workingSet, p.pageSpan));
+    for (int unit = std::max(p.pagedUnits, cpuDone); unit < cpuDone + units; ++unit) {
+        for (PageRef &ref : refs) {
+            uint64_t r = nextRandom(rng);
+            bool local = static_cast<int>(r % 100) < locality;
+            ref = PageRef{p.pid, static_cast<int>((r >> 32) % static_cast<uint64_t>(local ? hot : p.pageSpan)), false};
+        }
+        p.pagedUnits = unit + 1;
+        references += PAGE_REFS_PER_UNIT;
+        if (memory.accessPages(refs, PAGE_REFS_PER_UNIT).faults > 0) return unit - cpuDone;
+    }
+    return -1;
+}
+
+// ---------------- Simulación por eventos ----------------
+
+// La ejecución avanza el reloj virtual; solo con ritmo de demostración se espera,
+// y entonces sin el cerrojo para no bloquear el menú
+void ProcessManager::advanceClock(std::unique_lock<std::mutex>& lock, int units) {
+    virtualTime += units;
+    if (pacingMs > 0 && units > 0) {
+        long long ms = static_cast<long long>(pacingMs) * units;
+        recordHold();
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        lock.lock();
+        lockedSince = std::chrono::steady_clock::now();
+    }
+}
+
+int ProcessManager::levelQuantum(const Process& p) const {
+    return schedulerType == SchedulerType::MLFQ ? mlfqQuanta[p.level] : timeQuantum;
+}
+
+// Estado de una ejecución de simulate(): colas de listos, clase de tiempo real,
+// disco compartido y contadores. run() saca los eventos en orden y cada tipo tiene
+// su manejador; cuando ya se atendió todo el instante se expulsa y se despacha
+class ProcessManager::EventSimulation {
+public:
+    EventSimulation(const SimulationConfig& config, std::vector<Process>& batch, bool verbose,
+                    std::vector<GanttSlice>* gantt, std::vector<ProcessMetrics>* metrics);
+    SimulationSummary run();
+
+private:
+    const SimulationConfig &config;
+    std::vector<Process> &batch;
+    bool verbose;
+    std::vector<GanttSlice> *gantt;
+    std::vector<ProcessMetrics> *metrics;
+    MemoryManager *pager;
+    bool mlfq;
+    bool srtf;
+    bool byLength;
+    bool cfs;
+    bool rms;
+    bool adaptive;
+    QuantumTuner tuner;
+    EventQueue events;
+    long long sliceStart = 0;
+    long long rtHorizon = 0;
+
+    // RR y MLFQ: una cola por nivel (RR solo usa el nivel 0). SJF y SRTF: montículo
+    // por tiempo restante, desempatado por orden de llegada a la cola
+    std::deque<int> ready[MLFQ_LEVELS];
+    unsigned readyMask = 0;
+    std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>> shortest;
+    long long readyOrder = 0;
+    // CFS: peso total de los procesos en el sistema y menor vruntime visto
+    std::set<CfsEntry> tree;
+    long long runnableWeight = 0;
+    long long minVruntime = 0;
+    long long maxLag = 0;
+    // Tiempo real: plazo de la activación en curso y activaciones pendientes detrás
+    std::priority_queue<std::pair<long long, long long>, std::vector<std::pair<long long, long long>>,
+                        std::greater<std::pair<long long, long long>>> realTime;   // (clave, orden*n + índice)
+    std::vector<long long> jobDeadline;
+    std::vector<long long> jobRelease;
+    std::vector<long long> jobFirstRun;
+    std::vector<bool> jobActive;
+    std::vector<std::deque<long long>> backlog;
+    std::vector<bool> moreReleases;
+    long long rtJobs = 0;
+    long long deadlineMisses = 0;
+    long long maxLateness = 0;
+    long long rtResponse = 0;
+    long long rtTurnaround = 0;
+    long long rtMaxTurnaround = 0;
+    // Por tarea: activaciones terminadas y sus tiempos acumulados, para la tabla de procesos
+    std::vector<long long> taskJobs;
+    std::vector<long long> taskResponse;
+    std::vector<long long> taskTurnaround;
+
+    // Contabilidad: desde cuándo espera cada proceso y cuándo se despachó por primera vez
+    std::vector<long long> readySince;
+    std::vector<long long> firstRun;
+    long long busy = 0;
+    long long totalWaiting = 0;
+    long long totalResponse = 0;
+    long long totalTurnaround = 0;
+    long long normalDone = 0;    // Terminados fuera de la clase de tiempo real
+    long long deviceFree = 0;    // Instante en que el disco queda libre
+    long long deviceBusy = 0;
+    long long ioRequests = 0;
+    long long classDone[2] = {0, 0};          // [0] solo CPU, [1] con E/S
+    long long classTurnaround[2] = {0, 0};
+    long long classFinish[2] = {0, 0};
+    long long pageReferences = 0;
+    long long pageFaults = 0;
+    std::vector<uint64_t> pageRng;
+
+    int running = -1;
+    long long runningEvent = -1;   // seq del evento que cierra el turno actual
+    long long dispatches = 0;
+    long long preemptions = 0;
+    int lastOnCpu = -1;
+    long long contextSwitches = 0;
+    long long switchOverhead = 0;
+    long long quantumTotal = 0;
+    long long quantumTurns = 0;
+    long long finishTime = 0;
+    int pending;
+
+    bool isRealTime(int index) const { return batch[index].deadline > 0; }
+    long long rtKey(int index) const;
+    void startJob(int index, long long release);
+    void closeSlice(int index, long long now);
+    void enqueue(int index, bool front);
+
+    void onArrival(const SimEvent& event);
+    void onRealTimeRelease(const SimEvent& event);
+    void onIOBlock(const SimEvent& event);
+    void onPageBlock(const SimEvent& event);
+    void onWakeUp(const SimEvent& event);
+    void onQuantumExpiry(const SimEvent& event);
+    void onCompletion(const SimEvent& event);
+    bool finishJob(int index, long long now);
+    void onPriorityBoost(const SimEvent& event);
+    bool preemptRunning(long long now, bool rtReady, int top);
+    void dispatchNext(long long now, bool rtReady, int top);
+    SimulationSummary summarize(double wallSeconds);
+};
+
+ProcessManager::EventSimulation::EventSimulation(const SimulationConfig& config, std::vector<Process>& batch,
+                                                 bool verbose, std::vector<GanttSlice>* gantt,
+                                                 std::vector<ProcessMetrics>* metrics)
+    : config(config), batch(batch), verbose(verbose), gantt(gantt), metrics(metrics), pager(config.pager),
+      mlfq(config.scheduler == SchedulerType::MLFQ), srtf(config.scheduler == SchedulerType::SRTF),
+      byLength(config.scheduler == SchedulerType::SJF || srtf), cfs(config.scheduler == SchedulerType::CFS),
+      rms(config.rtPolicy == RealTimePolicy::RMS),
+      adaptive(config.scheduler == SchedulerType::RR && config.adaptivePercentile > 0),
+      jobDeadline(batch.size(), 0), jobRelease(batch.size(), 0), jobFirstRun(batch.size(), -1),
+      jobActive(batch.size(), false), backlog(batch.size()), moreReleases(batch.size(), false),
+      taskJobs(batch.size(), 0), taskResponse(batch.size(), 0), taskTurnaround(batch.size(), 0),
+      readySince(batch.size(), 0), firstRun(batch.size(), -1), pageRng(batch.size()),
+      pending(static_cast<int>(batch.size())) {
+    tuner.reset(config.quantum, config.adaptivePercentile);
+
+    // Las activaciones periódicas se generan durante dos hiperperiodos, con un tope
+    // de 100000 unidades
+    long long hyperperiod = 1;
+    long long lastRtArrival = 0;
+    for (const Process &p : batch) {
+        if (p.deadline <= 0 || p.period <= 0) continue;
+        hyperperiod = std::min(100000LL, hyperperiod / std::gcd(hyperperiod, static_cast<long long>(p.period)) * p.period);
+        lastRtArrival = std::max(lastRtArrival, static_cast<long long>(p.arrivalTime));
+    }
+    rtHorizon = lastRtArrival + std::min(100000LL, 2 * hyperperiod);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].level = mlfq ? batch[i].priority : 0;
+        batch[i].waitTime = 0;
+        batch[i].vruntime = 0;
+        batch[i].cpuSinceIo = 0;
+        batch[i].pagedUnits = 0;
+        events.schedule(batch[i].arrivalTime, EventType::ARRIVAL, static_cast<int>(i));
+        pageRng[i] = static_cast<uint64_t>(batch[i].pid) * 0x2545F4914F6CDD1DULL;
+    }
+    if (mlfq && config.boostInterval > 0 && !batch.empty()) {
+        events.schedule(config.boostInterval, EventType::PRIORITY_BOOST, -1);
+    }
+    if (gantt != nullptr) gantt->clear();
+    if (metrics != nullptr) metrics->clear();
+}
+
+long long ProcessManager::EventSimulation::rtKey(int index) const {
+    if (!rms) return jobDeadline[index];
+    return batch[index].period > 0 ? batch[index].period : batch[index].deadline;
+}
+
+void ProcessManager::EventSimulation::startJob(int index, long long release) {
+    batch[index].remainingTime = batch[index].burstTime;
+    jobDeadline[index] = release + batch[index].deadline;
+    jobRelease[index] = release;
+    jobFirstRun[index] = -1;
+    jobActive[index] = true;
+}
+
+// Durante el cambio de contexto (now < sliceStart) el proceso aún no usó la CPU
+void ProcessManager::EventSimulation::closeSlice(int index, long long now) {
+    busy += std::max(0LL, now - sliceStart);
+    if (gantt != nullptr && now > sliceStart) gantt->push_back(GanttSlice{batch[index].pid, sliceStart, now});
+}
+
+void ProcessManager::EventSimulation::enqueue(int index, bool front) {
+    readySince[index] = events.getTime();
+    if (isRealTime(index)) {
+        realTime.push({rtKey(index), readyOrder++ * static_cast<long long>(batch.size()) + index});
+        return;
+    }
+    if (cfs) {
+        tree.insert(CfsEntry{batch[index].vruntime, readyOrder++, index});
+        return;
+    }
+    if (byLength) {
+        shortest.push(ReadyEntry{batch[index].remainingTime, readyOrder++, index});
+        return;
+    }
+    int level = batch[index].level;
+    if (front) ready[level].push_front(index);
+    else ready[level].push_back(index);
+    readyMask |= 1u << level;
+    if (adaptive) tuner.observe(batch[index].remainingTime);
+}
+
+void ProcessManager::EventSimulation::onArrival(const SimEvent& event) {
+    if (isRealTime(event.process)) {
+        onRealTimeRelease(event);
+        return;
+    }
+    Process &p = batch[event.process];
+    p.state = ProcessState::Listo;
+    if (cfs) {
+        p.vruntime = std::max(p.vruntime, minVruntime);
+        runnableWeight += cfsWeights[p.priority];
+    }
+    enqueue(event.process, false);
+}
+
+// Activación: programa la siguiente y empieza ya si la anterior terminó; si no,
+// espera detrás
+void ProcessManager::EventSimulation::onRealTimeRelease(const SimEvent& event) {
+    Process &p = batch[event.process];
+    moreReleases[event.process] = p.period > 0 && event.time + p.period < rtHorizon;
+    if (moreReleases[event.process]) {
+        events.schedule(event.time + p.period, EventType::ARRIVAL, event.process);
+    }
+    if (jobActive[event.process]) {
+        backlog[event.process].push_back(event.time);
+        return;
+    }
+    startJob(event.process, event.time);
+    p.state = ProcessState::Listo;
+    enqueue(event.process, false);
+}
+
+// Deja la CPU y espera al disco; sin agotar el quantum, MLFQ no lo baja
+void ProcessManager::EventSimulation::onIOBlock(const SimEvent& event) {
+    Process &p = batch[event.process];
+    int ran = static_cast<int>(event.time - sliceStart);
+    p.remainingTime -= ran;
+    p.cpuSinceIo = 0;
+    p.state = ProcessState::Bloqueado;
+    closeSlice(event.process, event.time);
+    if (cfs) {
+        p.vruntime += cfsDelta(ran, cfsWeights[p.priority]);
+        runnableWeight -= cfsWeights[p.priority];
+    }
+    deviceFree = std::max(deviceFree, event.time) + p.ioDuration;
+    deviceBusy += p.ioDuration;
+    ioRequests++;
+    events.schedule(deviceFree, EventType::IO_COMPLETE, event.process);
+    running = -1;
+    if (verbose) {
+        std::cout << "[t=" << event.time << "] 💤 Proceso " << p.pid << " bloqueado por E/S hasta t="
+                  << deviceFree << " (Restante: " << p.remainingTime << ")\n";
+    }
+}
+
+// Igual que la E/S, pero su CPU cuenta para el siguiente punto de E/S
+void ProcessManager::EventSimulation::onPageBlock(const SimEvent& event) {
+    Process &p = batch[event.process];
+    int ran = static_cast<int>(event.time - sliceStart);
+    p.remainingTime -= ran;
+    p.cpuSinceIo += ran;
+    p.state = ProcessState::Bloqueado;
+    closeSlice(event.process, event.time);
+    if (cfs) {
+        p.vruntime += cfsDelta(ran, cfsWeights[p.priority]);
+        runnableWeight -= cfsWeights[p.priority];
+    }
+    deviceFree = std::max(deviceFree, event.time) + config.pageInDelay;
+    deviceBusy += config.pageInDelay;
+    pageFaults++;
+    events.schedule(deviceFree, EventType::PAGE_FAULT, event.process);
+    running = -1;
+    if (verbose) {
+        std::cout << "[t=" << event.time << "] 📄 Proceso " << p.pid << " bloqueado por fallo de página hasta t="
+                  << deviceFree << " (Restante: " << p.remainingTime << ")\n";
+    }
+}
+
+// IO_COMPLETE y PAGE_FAULT: el disco terminó y el proceso vuelve a la cola
+void ProcessManager::EventSimulation::onWakeUp(const SimEvent& event) {
+    Process &p = batch[event.process];
+    p.state = ProcessState::Listo;
+    if (cfs) {
+        p.vruntime = std::max(p.vruntime, minVruntime);
+        runnableWeight += cfsWeights[p.priority];
+    }
+    enqueue(event.process, false);
+    if (verbose) {
+        std::cout << "[t=" << event.time << "] 🔔 Proceso " << p.pid
+                  << (event.type == EventType::IO_COMPLETE ? " terminó su E/S\n" : " tiene su página en memoria\n");
+    }
+}
+
+void ProcessManager::EventSimulation::onQuantumExpiry(const SimEvent& event) {
+    Process &p = batch[event.process];
+    p.remainingTime -= static_cast<int>(event.time - sliceStart);
+    p.cpuSinceIo += static_cast<int>(event.time - sliceStart);
+    p.state = ProcessState::Listo;
+    closeSlice(event.process, event.time);
+    if (cfs) p.vruntime += cfsDelta(static_cast<int>(event.time - sliceStart), cfsWeights[p.priority]);
+    // Agotó el quantum: en MLFQ baja un nivel
+    if (mlfq && p.level < MLFQ_LEVELS - 1) p.level++;
+    enqueue(event.process, false);
+    running = -1;
+    if (verbose) {
+        std::cout << "[t=" << event.time << "] ↩️  Proceso " << p.pid
+                  << " vuelve a cola (Restante: " << p.remainingTime;
+        if (mlfq) std::cout << ", nivel " << p.level;
+        std::cout << ")\n";
+    }
+}
+
+void ProcessManager::EventSimulation::onCompletion(const SimEvent& event) {
+    Process &p = batch[event.process];
+    p.remainingTime = 0;
+    p.state = ProcessState::Listo;
+    closeSlice(event.process, event.time);
+    running = -1;
+    if (isRealTime(event.process)) {
+        if (finishJob(event.process, event.time)) return;
+    } else if (cfs) {
+        runnableWeight -= cfsWeights[p.priority];
+    }
+    finishTime = event.time;
+    pending--;
+    if (isRealTime(event.process)) {
+        // La tabla muestra la media por activación; las medias generales no la incluyen
+        long long jobs = std::max(1LL, taskJobs[event.process]);
+        if (metrics != nullptr) {
+            metrics->push_back(ProcessMetrics{p.pid, p.arrivalTime, p.burstTime,
+                                                 taskResponse[event.process] / jobs, p.waitTime / jobs,
+                                                 taskTurnaround[event.process] / jobs});
+        }
+        if (verbose) std::cout << "[t=" << event.time << "] ✅ Proceso " << p.pid << " completó su ejecución\n";
+        return;
+    }
+    long long response = firstRun[event.process] - p.arrivalTime;
+    long long turnaround = event.time - p.arrivalTime;
+    totalWaiting += p.waitTime;
+    totalResponse += response;
+    totalTurnaround += turnaround;
+    normalDone++;
+    int kind = p.ioInterval > 0 ? 1 : 0;
+    classDone[kind]++;
+    classTurnaround[kind] += turnaround;
+    classFinish[kind] = event.time;
+    if (metrics != nullptr) {
+        metrics->push_back(ProcessMetrics{p.pid, p.arrivalTime, p.burstTime, response, p.waitTime, turnaround});
+    }
+    if (verbose) std::cout << "[t=" << event.time << "] ✅ Proceso " << p.pid << " completó su ejecución\n";
+}
+
+// Cierra una activación de tiempo real, medida desde su liberación y no desde la
+// primera llegada. Devuelve true si a la tarea le quedan activaciones: arranca la
+// siguiente pendiente o espera a que se libere
+bool ProcessManager::EventSimulation::finishJob(int index, long long now) {
+    const Process &p = batch[index];
+    rtJobs++;
+    long long jobTurnaround = now - jobRelease[index];
+    rtResponse += jobFirstRun[index] - jobRelease[index];
+    rtTurnaround += jobTurnaround;
+    rtMaxTurnaround = std::max(rtMaxTurnaround, jobTurnaround);
+    taskJobs[index]++;
+    taskResponse[index] += jobFirstRun[index] - jobRelease[index];
+    taskTurnaround[index] += jobTurnaround;
+    long long lateness = now - jobDeadline[index];
+    if (lateness > 0) {
+        deadlineMisses++;
+        maxLateness = std::max(maxLateness, lateness);
+        if (verbose) {
+            std::cout << "[t=" << now << "] ⚠️  Proceso " << p.pid << " perdió su plazo (t=" << jobDeadline[index]
+                      << ")\n";
+        }
+    }
+    jobActive[index] = false;
+    if (verbose && (!backlog[index].empty() || moreReleases[index])) {
+        std::cout << "[t=" << now << "] ✅ Proceso " << p.pid << " completó una activación\n";
+    }
+    if (!backlog[index].empty()) {
+        startJob(index, backlog[index].front());
+        backlog[index].pop_front();
+        enqueue(index, false);
+        return true;
+    }
+    return moreReleases[index];
+}
+
+// Todos al nivel 0, en orden de nivel, para que nadie muera de inanición
+void ProcessManager::EventSimulation::onPriorityBoost(const SimEvent& event) {
+    if (pending == 0) return;   // Quedó programado tras el último proceso
+    for (int level = 1; level < MLFQ_LEVELS; ++level) {
+        for (int index : ready[level]) {
+            batch[index].level = 0;
+            ready[0].push_back(index);
+        }
+        ready[level].clear();
+    }
+    if (!ready[0].empty()) readyMask = 1u;
+    if (running != -1) batch[running].level = 0;
+    if (verbose) std::cout << "[t=" << event.time << "] 🚀 Impulso de prioridad: todos al nivel 0\n";
+    events.schedule(event.time + config.boostInterval, EventType::PRIORITY_BOOST, -1);
+}
+
+// Expulsión: la clase de tiempo real expulsa a la normal, y dentro de ella gana el
+// plazo más cercano (EDF) o el periodo más corto (RMS). En la clase normal, MLFQ
+// expulsa por un proceso de un nivel más alto y SRTF por uno con menos tiempo
+// restante que lo que le queda al que está en CPU. Devuelve true si liberó la CPU
+bool ProcessManager::EventSimulation::preemptRunning(long long now, bool rtReady, int top) {
+    Process &p = batch[running];
+    int ran = static_cast<int>(std::max(0LL, now - sliceStart));
+    int left = p.remainingTime - ran;
+    bool preempt;
+    if (isRealTime(running)) preempt = rtReady && realTime.top().first < rtKey(running);
+    else if (rtReady) preempt = true;
+    else preempt = (mlfq && top < p.level) || (srtf && shortest.top().remaining < left);
+    if (!preempt) return false;
+    int by = rtReady ? static_cast<int>(realTime.top().second % static_cast<long long>(batch.size()))
+                     : srtf ? shortest.top().id : -1;
+    if (cfs && !isRealTime(running)) {
+        p.vruntime += cfsDelta(ran, cfsWeights[p.priority]);
+    }
+    p.remainingTime = left;
+    p.cpuSinceIo += ran;
+    p.state = ProcessState::Listo;
+    closeSlice(running, now);
+    enqueue(running, true);
+    preemptions++;
+    if (verbose) {
+        std::cout << "[t=" << now << "] ⚡ Proceso " << p.pid << " expulsado por ";
+        if (by == -1) std::cout << "uno del nivel " << top;
+        else std::cout << "el proceso " << batch[by].pid;
+        std::cout << " (Restante: " << p.remainingTime << ")\n";
+    }
+    running = -1;
+    return true;
+}
+
+// Elige el siguiente proceso y programa el evento que cerrará su turno: fin de
+// quantum, terminación, punto de E/S o primer fallo de página
+void ProcessManager::EventSimulation::dispatchNext(long long now, bool rtReady, int top) {
+    if (rtReady) {
+        running = static_cast<int>(realTime.top().second % static_cast<long long>(batch.size()));
+        realTime.pop();
+    } else if (cfs) {
+        // El menor vruntime del árbol es el mínimo del sistema: la CPU está libre.
+        // La distancia al mayor mide cuánto se aleja el reparto del ideal
+        running = tree.begin()->id;
+        minVruntime = std::max(minVruntime, tree.begin()->vruntime);
+        maxLag = std::max(maxLag, tree.rbegin()->vruntime - tree.begin()->vruntime);
+        tree.erase(tree.begin());
+    } else if (byLength) {
+        running = shortest.top().id;
+        shortest.pop();
+    } else {
+        running = ready[top].front();
+        ready[top].pop_front();
+        if (ready[top].empty()) readyMask &= ~(1u << top);
+    }
+    Process &chosen = batch[running];
+    chosen.state = ProcessState::Ejecutando;
+    chosen.waitTime += static_cast<int>(now - readySince[running]);
+    int overhead = 0;
+    if (running != lastOnCpu) {
+        contextSwitches++;
+        overhead = config.contextSwitchCost;
+        lastOnCpu = running;
+    }
+    long long start = now + overhead;
+    if (firstRun[running] == -1) firstRun[running] = start;
+    if (isRealTime(running) && jobFirstRun[running] == -1) jobFirstRun[running] = start;
+    int slice = chosen.remainingTime;
+    if (isRealTime(running)) {
+        slice = chosen.remainingTime;
+    } else if (cfs) {
+        slice = std::min(cfsSlice(config.cfsTargetLatency, config.cfsMinGranularity, cfsWeights[chosen.priority],
+                                  runnableWeight), slice);
+    } else if (!byLength) {
+        int quantum = adaptive ? tuner.next() : mlfq ? config.mlfqQuanta[chosen.level] : config.quantum;
+        quantumTotal += quantum;
+        quantumTurns++;
+        slice = std::min(quantum, slice);
+    }
+    EventType end = slice == chosen.remainingTime ? EventType::COMPLETION : EventType::QUANTUM_EXPIRY;
+    // El turno acaba antes si llega a su punto de E/S
+    if (!isRealTime(running) && chosen.ioInterval > 0) {
+        int untilIo = std::max(1, chosen.ioInterval - chosen.cpuSinceIo);
+        if (untilIo < chosen.remainingTime && untilIo <= slice) {
+            slice = untilIo;
+            end = EventType::IO_BLOCK;
+        }
+    }
+    // ...o en su primer fallo de página
+    if (!isRealTime(running) && chosen.pageSpan > 0 && pager != nullptr) {
+        int untilFault = replayPages(*pager, chosen, pageRng[running], chosen.burstTime - chosen.remainingTime,
+                                     slice, config.localityPercent, pageReferences);
+        if (untilFault != -1) {
+            slice = untilFault;
+            end = EventType::PAGE_BLOCK;
+        }
+    }
+    sliceStart = start;
+    dispatches++;
+    switchOverhead += overhead;
+    runningEvent = events.schedule(start + slice, end, running);
+    if (verbose) {
+        std::cout << "[t=" << now << "] ⏰ Proceso " << chosen.pid << " en CPU hasta t=" << start + slice;
+        if (overhead > 0) std::cout << " (cambio de contexto: " << overhead << ")";
+        if (mlfq) std::cout << " (nivel " << chosen.level << ")";
+        if (cfs) std::cout << " (vruntime " << chosen.vruntime / 1024 << ")";
+        std::cout << "\n";
+    }
+}
+
+// Se despacha cuando ya se atendieron todos los eventos del instante, así SJF elige
+// también entre los que llegan a la vez. Los eventos que cierran un turno ya
+// terminado por una expulsión (seq distinto de runningEvent) se descartan
+SimulationSummary ProcessManager::EventSimulation::run() {
+    auto wallStart = std::chrono::steady_clock::now();
+    while (!events.empty()) {
+        long long before = events.getTime();
+        SimEvent event = events.pop();
+        if (config.pacingMs > 0 && event.time > before) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(static_cast<long long>(config.pacingMs) *
+                                                                  (event.time - before)));
+        }
+        bool stale = (event.type == EventType::QUANTUM_EXPIRY || event.type == EventType::COMPLETION ||
+                      event.type == EventType::IO_BLOCK || event.type == EventType::PAGE_BLOCK) &&
+                     event.seq != runningEvent;
+        if (!stale) {
+            switch (event.type) {
+                case EventType::ARRIVAL: onArrival(event); break;
+                case EventType::IO_BLOCK: onIOBlock(event); break;
+                case EventType::PAGE_BLOCK: onPageBlock(event); break;
+                case EventType::IO_COMPLETE:
+                case EventType::PAGE_FAULT: onWakeUp(event); break;
+                case EventType::QUANTUM_EXPIRY: onQuantumExpiry(event); break;
+                case EventType::COMPLETION: onCompletion(event); break;
+                case EventType::PRIORITY_BOOST: onPriorityBoost(event); break;
+            }
+        }
+
+        bool normalReady = cfs ? !tree.empty() : byLength ? !shortest.empty() : readyMask != 0;
+        bool rtReady = !realTime.empty();
+        if ((!normalReady && !rtReady) || (!events.empty() && events.peek().time == event.time)) continue;
+        int top = readyMask != 0 ? __builtin_ctz(readyMask) : MLFQ_LEVELS;
+        if (running != -1 && !preemptRunning(event.time, rtReady, top)) continue;
+        dispatchNext(event.time, rtReady, top);
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+    return summarize(wall.count());
+}
+
+SimulationSummary ProcessManager::EventSimulation::summarize(double wallSeconds) {
+    SimulationSummary summary{static_cast<int>(batch.size()), finishTime, events.getProcessed(), dispatches,
+                              preemptions, wallSeconds, 0.0, 0.0, 0.0, 0.0, 0.0, maxLag / 1024.0,
+                              rtJobs, deadlineMisses, maxLateness};
+    if (normalDone > 0) {
+        summary.avgWaiting = static_cast<double>(totalWaiting) / normalDone;
+        summary.avgResponse = static_cast<double>(totalResponse) / normalDone;
+        summary.avgTurnaround = static_cast<double>(totalTurnaround) / normalDone;
+    }
+    summary.rtTasks = static_cast<int>(std::count_if(batch.begin(), batch.end(),
+                                                     [](const Process& p) { return p.deadline > 0; }));
+    if (rtJobs > 0) {
+        summary.rtAvgResponse = static_cast<double>(rtResponse) / rtJobs;
+        summary.rtAvgTurnaround = static_cast<double>(rtTurnaround) / rtJobs;
+        summary.rtMaxTurnaround = rtMaxTurnaround;
+    }
+    if (finishTime > 0) {
+        summary.throughput = static_cast<double>(batch.size()) / finishTime;
+        summary.utilization = static_cast<double>(busy) / finishTime;
+        summary.deviceUtilization = static_cast<double>(deviceBusy) / finishTime;
+    }
+    summary.ioRequests = ioRequests;
+    summary.pageReferences = pageReferences;
+    summary.pageFaults = pageFaults;
+    summary.contextSwitches = contextSwitches;
+    summary.switchOverhead = switchOverhead;
+    summary.avgQuantum = quantumTurns > 0 ? static_cast<double>(quantumTotal) / quantumTurns : 0.0;
+    summary.quantumRetunes = tuner.getRetunes();
+    if (classDone[1] > 0) {
+        summary.ioBoundTurnaround = static_cast<double>(classTurnaround[1]) / classDone[1];
+        summary.ioBoundThroughput = classFinish[1] > 0 ? static_cast<double>(classDone[1]) / classFinish[1] : 0.0;
+    }
+    if (classDone[0] > 0) {
+        summary.cpuBoundTurnaround = static_cast<double>(classTurnaround[0]) / classDone[0];
+        summary.cpuBoundThroughput = classFinish[0] > 0 ? static_cast<double>(classDone[0]) / classFinish[0] : 0.0;
+    }
+    if (metrics != nullptr) {
+        std::sort(metrics->begin(), metrics->end(),
+                  [](const ProcessMetrics& a, const ProcessMetrics& b) { return a.pid < b.pid; });
+    }
+    return summary;
+}
+
+// Ejecuta el lote con la política actual sobre un reloj virtual: llegadas, fin de
+// quantum y terminación son eventos, atendidos por EventSimulation.
+// En MLFQ un mapa de bits da en O(1) el nivel más alto con procesos listos, y en
+// CFS un árbol por vruntime da el siguiente en O(log n).
+// Espera, respuesta y retorno se acumulan al despachar y al terminar; con gantt y
+// metrics se guardan además el Gantt y los tiempos de cada proceso.
+// Las tareas de tiempo real (plazo > 0) forman una clase aparte que expulsa a la
+// política normal: cada activación es una llegada que repone la ráfaga, y si la
+// anterior no terminó queda en espera detrás de ella. Se ordenan por plazo
+// absoluto (EDF) o por periodo (RMS).
+// Los procesos con ioInterval > 0 dejan la CPU cada ioInterval unidades para usar
+// un disco FIFO compartido; vuelven a la cola con el evento IO_COMPLETE, así la
+// CPU atiende a otros mientras tanto.
+// Los procesos con pageSpan > 0 reproducen sus referencias en el gestor de memoria
+// al recibir la CPU; el turno se corta en el primer fallo (PAGE_BLOCK) y la lectura
+// de la página usa el mismo disco, así con mucha multiprogramación la CPU espera al
+// disco (thrashing).
+// Cada despacho de un proceso distinto del último que usó la CPU es un cambio de
+// contexto que consume contextSwitchCost unidades antes del turno; en RR adaptativo
+// el quantum de cada turno lo da un QuantumTuner alimentado por la cola de listos.
+// No toca el estado del gestor, así se llama sin mtx tomado
+SimulationSummary ProcessManager::simulate(const SimulationConfig& config, std::vector<Process>& batch, bool verbose,
+                                           std::vector<GanttSlice>* gantt, std::vector<ProcessMetrics>* metrics) {
+    EventSimulation simulation(config, batch, verbose, gantt, metrics);
+    return simulation.run();
+}
+
+// Con mtx tomado: los parámetros actuales, para simular después sin el cerrojo
+ProcessManager::SimulationConfig ProcessManager::simulationConfig() const {
+    SimulationConfig config{schedulerType, rtPolicy, timeQuantum, {}, boostInterval, adaptivePercentile,
+                            contextSwitchCost, cfsTargetLatency, cfsMinGranularity, pacingMs, pageInDelay,
+                            localityPercent, memoryManager};
+    std::copy(mlfqQuanta, mlfqQuanta + MLFQ_LEVELS, config.mlfqQuanta);
+    return config;
+}
+
+static void printSummary(const SimulationSummary& summary, const char* label) {
+    double rate = summary.wallSeconds > 0 ? summary.events / summary.wallSeconds : 0.0;
+    std::cout << "📊 " << label << ": " << summary.processes << " procesos | Tiempo virtual: "
+              << summary.finishTime << " | Eventos: " << summary.events << " | Despachos: "
+              << summary.dispatches;
+    if (summary.preemptions > 0) std::cout << " | Expulsiones: " << summary.preemptions;
+    std::cout << " | Cambios de contexto: " << summary.contextSwitches;
+    if (summary.switchOverhead > 0) std::cout << " (" << summary.switchOverhead << " u de sobrecarga)";
+    std::cout << "\n";
+    std::cout << "   ";
+    if (summary.processes > summary.rtTasks) {
+        std::cout << "Espera media: " << summary.avgWaiting << " | Respuesta media: " << summary.avgResponse
+                  << " | Retorno medio: " << summary.avgTurnaround << " | ";
+    }
+    std::cout << "Throughput: " << summary.throughput << " proc/u | Uso de CPU: " << summary.utilization * 100 << "%";
+    if (summary.fairnessLag > 0) std::cout << " | Desfase de vruntime máx: " << summary.fairnessLag;
+    std::cout << "\n";
+    if (summary.rtJobs > 0) {
+        std::cout << "   Clase de tiempo real: " << summary.rtJobs << " activaciones | Plazos perdidos: " << summary.deadlineMisses
+                  << " (" << 100.0 * summary.deadlineMisses / summary.rtJobs << "%) | Retraso máx: "
+                  << summary.maxLateness << "\n";
+        std::cout << "   Por activación: respuesta media " << summary.rtAvgResponse << " | retorno medio "
+                  << summary.rtAvgTurnaround << " | retorno máx " << summary.rtMaxTurnaround
+                  << " (fuera de las medias generales)\n";
+    }
+    if (summary.ioRequests > 0) {
+        std::cout << "   E/S: " << summary.ioRequests << " solicitudes | Uso del disco: "
+                  << summary.deviceUtilization * 100 << "% | Con E/S: retorno medio " << summary.ioBoundTurnaround
+                  << ", throughput " << summary.ioBoundThroughput << " proc/u | Solo CPU: retorno medio "
+                  << summary.cpuBoundTurnaround << ", throughput " << summary.cpuBoundThroughput << " proc/u\n";
+    }
+    if (summary.pageReferences > 0) {
+        std::cout << "   Paginación: " << summary.pageReferences << " referencias | Fallos: " << summary.pageFaults
+                  << " (" << 100.0 * summary.pageFaults / summary.pageReferences << "%) | Uso del disco: "
+                  << summary.deviceUtilization * 100 << "%\n";
+    }
+    std::cout << "   Tiempo real: " << summary.wallSeconds << " s (" << static_cast<long long>(rate)
+              << " eventos/s)\n";
+}
+
+// Tabla de tiempos por proceso de la última simulación registrada
+void ProcessManager::printMetrics() const {
+    if (lastMetrics.size() > 50) return;
+    std::cout << "PID | Llegada | Ráfaga | Respuesta | Espera | Retorno\n";
+    for (const ProcessMetrics &m : lastMetrics) {
+        std::cout << m.pid << " | " << m.arrival << " | " << m.burst << " | " << m.response << " | " << m.waiting
+                  << " | " << m.turnaround << "\n";
+    }
+}
+
+// Con mtx tomado: publica el resultado de una simulación para exportar el Gantt
+void ProcessManager::storeRun(const std::string& label, const SimulationSummary& summary,
+                              std::vector<GanttSlice>& gantt, std::vector<ProcessMetrics>& metrics) {
+    lastRunLabel = label;
+    lastSummary = summary;
+    lastGantt.swap(gantt);
+    lastMetrics.swap(metrics);
+}
+
+// Ejecuta hasta el final los procesos nuevos y listos; quedan con restante 0,
+// como tras scheduleRR/scheduleSJF, a la espera de terminarlos formalmente.
+// Los procesos del lote quedan en Ejecutando mientras se simulan sin el cerrojo,
+// así el planificador automático no los despacha a la vez
+SimulationSummary ProcessManager::runSimulation() {
+    std::vector<Process> batch;
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Process &p : processes) {
+            if ((p.state == ProcessState::Nuevo || p.state == ProcessState::Listo) && p.remainingTime > 0) {
+                batch.push_back(p);
+                p.state = ProcessState::Ejecutando;
+            }
+        }
+        if (batch.empty()) {
+            std::cout << "No hay procesos nuevos o listos para simular.\n";
+            return SimulationSummary{0, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0, 0};
+        }
+        clearReady();
+        config = simulationConfig();
+    }
+
+    std::cout << "\n=== Simulación por eventos (" << schedulerName(config.scheduler) << ") ===\n";
+    std::vector<GanttSlice> gantt;
+    std::vector<ProcessMetrics> metrics;
+    SimulationSummary summary = simulate(config, batch, batch.size() <= 50, &gantt, &metrics);
+
+    // Mientras tanto pudieron suspenderlos o terminarlos
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const Process &done : batch) {
+        int idx = findIndexByPid(done.pid);
+        if (idx == -1) continue;
+        Process &p = processes[idx];
+        if (p.state != ProcessState::Ejecutando && p.state != ProcessState::Suspendido) continue;
+        p.remainingTime = done.remainingTime;
+        p.waitTime = done.waitTime;
+        if (p.state == ProcessState::Ejecutando) p.state = done.state;
+    }
+    storeRun(schedulerName(config.scheduler), summary, gantt, metrics);
+    printMetrics();
+    printSummary(summary, "Simulación");
+    std::cout << "💡 Use la opción 7 para terminar formalmente los procesos.\n";
+    return summary;
+}
+
+// Lote sintético sin memoria asignada: llegadas cada 0-22 unidades y ráfagas de 1-20,
+// una carga de ~95% de la CPU. Se ejecuta con cada política
+void ProcessManager::runSimulationBenchmark(int processCount) {
+    std::mt19937 rng(42);
+    std::vector<Process> batch;
+    batch.reserve(processCount);
+    int arrival = 0;
+    for (int i = 0; i < processCount; ++i) {
+        arrival += static_cast<int>(rng() % 23);
+        int burst = 1 + static_cast<int>(rng() % 20);
+        int priority = static_cast<int>(rng() % 4);
+        batch.push_back(Process{i + 1, burst, arrival, priority, 0, ProcessState::Nuevo, burst, 0, 0, priority, -1, 0, 0, 0});
+    }
+
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    config.pacingMs = 0;
+    std::cout << "\n=== Benchmark del simulador por eventos (" << processCount << " procesos) ===\n";
+    for (SchedulerType type : {SchedulerType::RR, SchedulerType::SJF, SchedulerType::SRTF, SchedulerType::MLFQ,
+                               SchedulerType::CFS}) {
+        config.scheduler = type;
+        std::vector<Process> copy = batch;
+        SimulationSummary summary = simulate(config, copy, false);
+        printSummary(summary, schedulerName(type));
+    }
+}
+
+// Sin pasar por la tabla de procesos: el lote puede tener millones de procesos
+SimulationSummary ProcessManager::runWorkload(std::vector<Process>& batch, bool verbose) {
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    config.pacingMs = 0;
+    SimulationSummary summary = simulate(config, batch, false);
+    if (verbose) printSummary(summary, schedulerName(config.scheduler));
+    return summary;
+}
+
+// Mitad de procesos con E/S (cada 2-5 unidades de CPU, 1-4 en el disco) y mitad solo
+// CPU, con ráfagas de 20-59 y llegadas cada 0-89: CPU al ~90% y disco al ~30%.
+// Muestra con cada política cómo se solapan CPU y disco y qué clase sale ganando
+void ProcessManager::runIOBenchmark(int processCount) {
+    std::mt19937 rng(42);
+    std::vector<Process> batch;
+    batch.reserve(processCount);
+    int arrival = 0;
+    for (int i = 0; i < processCount; ++i) {
+        arrival += static_cast<int>(rng() % 90);
+        int burst = 20 + static_cast<int>(rng() % 40);
+        int priority = static_cast<int>(rng() % 4);
+        batch.push_back(Process{i + 1, burst, arrival, priority, 0, ProcessState::Nuevo, burst, 0, 0, priority, -1, 0, 0, 0});
+        if (i % 2 == 0) {
+            batch.back().ioInterval = 2 + static_cast<int>(rng() % 4);
+            batch.back().ioDuration = 1 + static_cast<int>(rng() % 4);
+        }
+    }
+
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    config.pacingMs = 0;
+    std::cout << "\n=== Benchmark de E/S (" << processCount << " procesos, mitad con E/S) ===\n";
+    for (SchedulerType type : {SchedulerType::RR, SchedulerType::SJF, SchedulerType::SRTF, SchedulerType::MLFQ,
+                               SchedulerType::CFS}) {
+        config.scheduler = type;
+        std::vector<Process> copy = batch;
+        SimulationSummary summary = simulate(config, copy, false);
+        printSummary(summary, schedulerName(type));
+    }
+}
+
+// El mismo lote con ráfagas de Pareto (media 8, cola pesada) y CPU al ~80% con RR de
+// quantum fijo y adaptativo: un quantum corto multiplica los cambios de contexto y
+// uno largo hace esperar a los procesos cortos detrás de los largos
+void ProcessManager::runAdaptiveQuantumBenchmark(int processCount) {
+    WorkloadGenerator generator(42);
+    std::vector<Process> batch = generator.makeProcesses(processCount, 10.0, 8.0, 1.5);
+
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    config.scheduler = SchedulerType::RR;
+    config.pacingMs = 0;
+    std::cout << "\n=== Round Robin: quantum fijo frente a adaptativo (" << processCount
+              << " procesos, cambio de contexto: " << config.contextSwitchCost << " u) ===\n";
+    std::cout << "Quantum | Quantum medio | Cambios de contexto | Sobrecarga | Respuesta media | Retorno medio | Uso de CPU\n";
+    auto row = [&](const std::string& label) {
+        std::vector<Process> copy = batch;
+        SimulationSummary summary = simulate(config, copy, false);
+        std::cout << label << " | " << summary.avgQuantum << " | " << summary.contextSwitches << " | "
+                  << summary.switchOverhead << " u | " << summary.avgResponse << " | " << summary.avgTurnaround
+                  << " | " << summary.utilization * 100 << "%\n";
+    };
+    int savedQuantum = config.quantum;
+    config.adaptivePercentile = 0;
+    for (int quantum : {1, 2, 4, 8, 16, 32}) {
+        config.quantum = quantum;
+        row("Fijo " + std::to_string(quantum));
+    }
+    config.quantum = savedQuantum;
+    for (int percentile : {50, 80, 90}) {
+        config.adaptivePercentile = percentile;
+        row("Adaptativo p" + std::to_string(percentile));
+    }
+}
+
+// Curva de capacidad: de 1 a maxLevel procesos iguales llegan a la vez y comparten
+// `frames` marcos. Mientras sus conjuntos de trabajo caben, cada proceso más solapa
+// CPU y disco; cuando dejan de caber, casi cada turno falla, el disco se satura y el
+// uso de CPU se desploma (thrashing)
+void ProcessManager::runThrashingCurve(int frames, int workingSet, int maxLevel) {
+    const int burst = 300;
+    // OPT necesita el lote completo de referencias; aquí llegan de unidad en unidad
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    PageReplacement policy = config.pager->getReplacementPolicy();
+    if (policy == PageReplacement::OPT) policy = PageReplacement::LRU;
+    // Cada nivel usa pids nuevos: las páginas de los anteriores no se vuelven a
+    // referenciar y son las primeras víctimas, como marcos libres
+    MemoryManager memory(frames);
+    memory.setReplacementPolicy(policy);
+    config.pager = &memory;
+    config.pacingMs = 0;
+    int nextPid = 1;
+
+    std::cout << "\n=== Curva de thrashing (" << schedulerName(config.scheduler) << ", " << frames
+              << " marcos, conjunto de " << workingSet << " páginas, lectura de " << config.pageInDelay << " u) ===\n";
+    std::cout << "Procesos | Marcos/proc | Uso CPU | Uso disco | Fallos/1000 ref | Throughput\n";
+    std::vector<double> utilization;
+    for (int level = 1; level <= maxLevel; ++level) {
+        std::vector<Process> batch;
+        for (int i = 0; i < level; ++i) {
+            batch.push_back(Process{nextPid++, burst, 0, 0, 0, ProcessState::Nuevo, burst, 0, 0, 0, -1, 0, 0, 0});
+            batch.back().pageSpan = workingSet * 2;
+            batch.back().workingSet = workingSet;
+        }
+        SimulationSummary summary = simulate(config, batch, false);
+        utilization.push_back(summary.utilization);
+        double faultRate = summary.pageReferences > 0 ? 1000.0 * summary.pageFaults / summary.pageReferences : 0.0;
+        std::cout << level << " | " << frames / level << " | " << summary.utilization * 100 << "% | "
+                  << summary.deviceUtilization * 100 << "% | " << faultRate << " | " << summary.throughput << " proc/u "
+                  << std::string(static_cast<size_t>(summary.utilization * 40 + 0.5), '#') << "\n";
+    }
+    if (utilization.empty()) return;
+    size_t best = std::max_element(utilization.begin(), utilization.end()) - utilization.begin();
+    std::cout << "📈 Máximo uso de CPU con " << best + 1 << " procesos (" << utilization[best] * 100 << "%)";
+    if (best + 1 < utilization.size()) {
+        std::cout << "; con " << utilization.size() << " cae al " << utilization.back() * 100 << "%";
+    }
+    std::cout << "\n";
+}
+
+// Exporta el Gantt de la última simulación registrada: JSON si la ruta termina en
+// .json (con los tiempos por proceso y el resumen), CSV con un tramo por fila si no
+bool ProcessManager::exportGantt(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mtx));
+    if (lastGantt.empty()) {
+        std::cout << "❌ No hay ninguna simulación registrada. Simule los procesos o ejecute un script antes.\n";
+        return false;
+    }
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cout << "❌ No se pudo crear " << path << "\n";
+        return false;
+    }
+
+    bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    if (json) {
+        std::string label;
+        for (char ch : lastRunLabel) {
+            if (ch == '"' || ch == '\\') label += '\\';
+            label += ch;
+        }
+        out << "{\n  \"simulacion\": \"" << label << "\",\n  \"gantt\": [\n";
+        for (size_t i = 0; i < lastGantt.size(); ++i) {
+            out << "    {\"pid\": " << lastGantt[i].pid << ", \"inicio\": " << lastGantt[i].start << ", \"fin\": "
+                << lastGantt[i].end << "}" << (i + 1 < lastGantt.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n  \"procesos\": [\n";
+        for (size_t i = 0; i < lastMetrics.size(); ++i) {
+            const ProcessMetrics &m = lastMetrics[i];
+            out << "    {\"pid\": " << m.pid << ", \"llegada\": " << m.arrival << ", \"rafaga\": " << m.burst
+                << ", \"respuesta\": " << m.response << ", \"espera\": " << m.waiting << ", \"retorno\": "
+                << m.turnaround << "}" << (i + 1 < lastMetrics.size() ? "," : "") << "\n";
+        }
+        out << "  ],\n  \"resumen\": {\"tiempo\": " << lastSummary.finishTime << ", \"espera_media\": "
+            << lastSummary.avgWaiting << ", \"respuesta_media\": " << lastSummary.avgResponse
+            << ", \"retorno_medio\": " << lastSummary.avgTurnaround << ", \"throughput\": " << lastSummary.throughput
+            << ", \"uso_cpu\": " << lastSummary.utilization;
+        if (lastSummary.rtJobs > 0) {
+            out << ", \"activaciones_rt\": " << lastSummary.rtJobs << ", \"respuesta_media_rt\": "
+                << lastSummary.rtAvgResponse << ", \"retorno_medio_rt\": " << lastSummary.rtAvgTurnaround
+                << ", \"plazos_perdidos\": " << lastSummary.deadlineMisses;
+        }
+        out << "}\n}\n";
+    } else {
+        out << "pid,inicio,fin\n";
+        for (const GanttSlice &slice : lastGantt) {
+            out << slice.pid << "," << slice.start << "," << slice.end << "\n";
+        }
+    }
+    std::cout << "📈 Gantt de " << lastRunLabel << " exportado a " << path << " (" << lastGantt.size()
+              << " tramos)\n";
+    return true;
+}
+
+// Ejecuta un script de procesos (scripts/proc_rr.txt, scripts/proc_sjf.txt) en una
+// simulación aislada: no crea procesos ni asigna memoria. Usa la política del script
+bool ProcessManager::runProcessScript(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cout << "❌ No se pudo abrir el script " << path << "\n";
+        return false;
+    }
+
+    SimulationConfig config;
+    bool admission;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+        admission = rtAdmission;
+    }
+    SchedulerType type = config.scheduler;
+    RealTimePolicy policy = config.rtPolicy;
+    int quantum = config.quantum;
+    std::vector<Process> batch;
+    std::unordered_map<int, std::pair<int, int>> ioProfiles;   // pid -> (intervalo, duración)
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.rfind("PLANIFICADOR:", 0) == 0) {
+            if (line.find("Round Robin") != std::string::npos) type = SchedulerType::RR;
+            else if (line.find("SRTF") != std::string::npos) type = SchedulerType::SRTF;
+            else if (line.find("SJF") != std::string::npos) type = SchedulerType::SJF;
+            else if (line.find("MLFQ") != std::string::npos) type = SchedulerType::MLFQ;
+            else if (line.find("CFS") != std::string::npos) type = SchedulerType::CFS;
+            continue;
+        }
+        if (line.rfind("Quantum:", 0) == 0) {
+            quantum = std::max(1, std::atoi(line.c_str() + 8));
+            continue;
+        }
+        if (line.rfind("TIEMPO REAL:", 0) == 0) {
+            policy = line.find("RMS") != std::string::npos ? RealTimePolicy::RMS : RealTimePolicy::EDF;
+            continue;
+        }
+        // "E/S: PID Intervalo Duracion": el proceso pide E/S cada Intervalo unidades de CPU
+        if (line.rfind("E/S:", 0) == 0) {
+            std::istringstream io(line.substr(4));
+            int pid, interval, duration;
+            if (io >> pid >> interval >> duration && interval > 0 && duration > 0) {
+                ioProfiles[pid] = {interval, duration};
+            }
+            continue;
+        }
+        // Filas "PID | Llegada | Rafaga [| Periodo | Plazo]"; la cabecera no es
+        // numérica y se salta
+        std::replace(line.begin(), line.end(), '|', ' ');
+        std::istringstream row(line);
+        int pid, arrival, burst;
+        if (row >> pid >> arrival >> burst && burst > 0) {
+            int period = 0;
+            int deadline = 0;
+            if (row >> period) {
+                if (!(row >> deadline) || deadline <= 0) deadline = period;
+                deadline = period > 0 ? std::min(deadline, period) : deadline;
+            }
+            batch.push_back(Process{pid, burst, arrival, 0, 0, ProcessState::Nuevo, burst, 0, 0, 0, -1, 0,
+                                    std::max(0, period), std::max(0, deadline)});
+        }
+    }
+    if (batch.empty()) {
+        std::cout << "❌ El script no contiene procesos\n";
+        return false;
+    }
+    for (Process &p : batch) {
+        auto it = ioProfiles.find(p.pid);
+        if (it == ioProfiles.end()) continue;
+        p.ioInterval = it->second.first;
+        p.ioDuration = it->second.second;
+    }
+
+    config.scheduler = type;
+    config.rtPolicy = policy;
+    config.quantum = quantum;
+    bool realTime = std::any_of(batch.begin(), batch.end(), [](const Process& p) { return p.deadline > 0; });
+    std::cout << "\n=== Script " << path << " (" << schedulerName(type);
+    if (type == SchedulerType::RR) std::cout << ", quantum " << quantum;
+    if (realTime) std::cout << ", tiempo real " << (policy == RealTimePolicy::EDF ? "EDF" : "RMS");
+    std::cout << ") ===\n";
+    bool admitted = !realTime || admitRealTime(batch, policy, true) || !admission;
+    if (admitted) {
+        std::vector<GanttSlice> gantt;
+        std::vector<ProcessMetrics> metrics;
+        SimulationSummary summary = simulate(config, batch, true, &gantt, &metrics);
+        std::lock_guard<std::mutex> lock(mtx);
+        storeRun(path, summary, gantt, metrics);
+        printMetrics();
+        printSummary(summary, "Script");
+    } else {
+        std::cout << "❌ Conjunto de tareas rechazado por el control de admisión\n";
+    }
+    return admitted;
+}
+
+void ProcessManager::setPacing(int msPerUnit) {
+    std::lock_guard<std::mutex> lock(mtx);
+    pacingMs = std::max(0, msPerUnit);
+    if (pacingMs == 0) std::cout << "⏱️  Simulación en tiempo virtual, sin esperas\n";
+    else std::cout << "⏱️  Ritmo de demostración: " << pacingMs << " ms reales por unidad de CPU\n";
+}
+
+void ProcessManager::setBoostInterval(int units) {
+    std::lock_guard<std::mutex> lock(mtx);
+    boostInterval = std::max(0, units);
+    if (boostInterval == 0) std::cout << "🚀 Impulso de prioridad MLFQ desactivado\n";
+    else std::cout << "🚀 Impulso de prioridad MLFQ cada " << boostInterval << " unidades\n";
+}
+
+// ---------------- Tiempo real ----------------
+
+// Prueba de utilización: EDF admite hasta U = 1 y RMS hasta la cota de Liu y Layland
+// n(2^(1/n) - 1). Con plazo menor que el periodo se suma C/D, que es más estricto
+bool ProcessManager::admitRealTime(const std::vector<Process>& tasks, RealTimePolicy policy, bool verbose) {
+    double load = 0.0;
+    int count = 0;
+    for (const Process &p : tasks) {
+        if (p.deadline <= 0) continue;
+        int window = p.period > 0 ? std::min(p.period, p.deadline) : p.deadline;
+        load += static_cast<double>(p.burstTime) / window;
+        count++;
+    }
+    if (count == 0) return true;
+    bool rms = policy == RealTimePolicy::RMS;
+    double bound = rms ? count * (std::pow(2.0, 1.0 / count) - 1.0) : 1.0;
+    bool admitted = load <= bound + 1e-9;
+    if (verbose) {
+        std::cout << "🕒 Admisión " << (rms ? "RMS" : "EDF") << ": U = " << load << " | cota = " << bound << " | "
+                  << count << " tareas → " << (admitted ? "admitido" : "rechazado") << "\n";
+    }
+    return admitted;
+}
+
+// Periodo 0 con plazo > 0: tarea esporádica de una sola activación. Plazo 0 con
+// periodo > 0: el plazo es el periodo. Ambos 0: vuelve a la clase normal
+bool ProcessManager::setRealTime(int pid, int period, int deadline) {
+    std::lock_guard<std::mutex> lock(mtx);
+    int idx = findIndexByPid(pid);
+    if (idx == -1) {
+        std::cout << "Proceso no encontrado.\n";
+        return false;
+    }
+    if (period < 0 || deadline < 0) {
+        std::cout << "❌ Periodo y plazo no pueden ser negativos.\n";
+        return false;
+    }
+    if (deadline == 0) deadline = period;
+    if (period > 0 && deadline > period) {
+        std::cout << "❌ El plazo no puede superar el periodo.\n";
+        return false;
+    }
+    if (deadline > 0 && deadline < processes[idx].burstTime) {
+        std::cout << "❌ La ráfaga (" << processes[idx].burstTime << ") no cabe en el plazo.\n";
+        return false;
+    }
+
+    if (deadline > 0) {
+        std::vector<Process> tasks;
+        for (const Process &p : processes) {
+            if (p.pid != -1 && p.pid != pid && p.deadline > 0) tasks.push_back(p);
+        }
+        Process candidate = processes[idx];
+        candidate.period = period;
+        candidate.deadline = deadline;
+        tasks.push_back(candidate);
+        if (!admitRealTime(tasks, rtPolicy, true) && rtAdmission) {
+            std::cout << "❌ Proceso " << pid << " rechazado por el control de admisión.\n";
+            return false;
+        }
+    }
+    processes[idx].period = period;
+    processes[idx].deadline = deadline;
+    if (deadline == 0) std::cout << "Proceso " << pid << " vuelve a la clase normal.\n";
+    else std::cout << "🕒 Proceso " << pid << " de tiempo real: periodo " << period << " | plazo " << deadline << "\n";
+    return true;
+}
+
+void ProcessManager::setRealTimePolicy(RealTimePolicy policy, bool admission) {
+    std::lock_guard<std::mutex> lock(mtx);
+    rtPolicy = policy;
+    rtAdmission = admission;
+    std::cout << "🕒 Clase de tiempo real: " << (policy == RealTimePolicy::EDF ? "EDF" : "RMS")
+              << " | Control de admisión: " << (admission ? "activo" : "desactivado") << "\n";
+}
+
+// Conjuntos de tareas periódicas con utilización creciente (periodos de 10 a 100,
+// hiperperiodo 200) y tres procesos normales de fondo. Cada conjunto se pasa por la
+// admisión de EDF y RMS y se simula con ambas sin rechazarlo, para ver las pérdidas
+void ProcessManager::runRealTimeBenchmark(int taskCount) {
+    static const int periods[] = {10, 20, 25, 40, 50, 100};
+    taskCount = std::max(1, taskCount);
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    config.scheduler = SchedulerType::RR;
+    config.pacingMs = 0;
+    std::cout << "\n=== Benchmark de tiempo real (" << taskCount << " tareas periódicas + 3 procesos normales) ===\n";
+    for (double target : {0.5, 0.7, 0.8, 0.9, 1.0, 1.2}) {
+        std::mt19937 rng(42);
+        std::vector<double> shares(taskCount);
+        double total = 0.0;
+        for (double &share : shares) {
+            share = 1.0 + rng() % 100;
+            total += share;
+        }
+        std::vector<Process> batch;
+        double load = 0.0;
+        for (int i = 0; i < taskCount; ++i) {
+            int period = periods[rng() % 6];
+            int burst = std::max(1, static_cast<int>(std::lround(target * shares[i] / total * period)));
+            load += static_cast<double>(burst) / period;
+            batch.push_back(Process{i + 1, burst, 0, 0, 0, ProcessState::Nuevo, burst, 0, 0, 0, -1, 0, period, period});
+        }
+        for (int i = 0; i < 3; ++i) {
+            int pid = taskCount + i + 1;
+            batch.push_back(Process{pid, 200, 0, 2, 0, ProcessState::Nuevo, 200, 0, 0, 2, -1, 0, 0, 0});
+        }
+
+        std::cout << "U = " << load << "\n";
+        for (RealTimePolicy policy : {RealTimePolicy::EDF, RealTimePolicy::RMS}) {
+            config.rtPolicy = policy;
+            bool admitted = admitRealTime(batch, policy, false);
+            std::vector<Process> copy = batch;
+            SimulationSummary summary = simulate(config, copy, false);
+            double missRate = summary.rtJobs > 0 ? 100.0 * summary.deadlineMisses / summary.rtJobs : 0.0;
+            std::cout << "   " << (policy == RealTimePolicy::EDF ? "EDF" : "RMS") << ": "
+                      << (admitted ? "admitido" : "rechazado") << " | " << summary.deadlineMisses << " plazos perdidos de "
+                      << summary.rtJobs << " (" << missRate << "%) | retraso máx " << summary.maxLateness
+                      << " | fondo terminado en t=" << summary.finishTime << "\n";
+        }
+    }
+}
+
+void ProcessManager::setCfsParams(int targetLatency, int minGranularity) {
+    std::lock_guard<std::mutex> lock(mtx);
+    cfsMinGranularity = std::max(1, minGranularity);
+    cfsTargetLatency = std::max(cfsMinGranularity, targetLatency);
+    std::cout << "⚖️  CFS: latencia objetivo " << cfsTargetLatency << " | granularidad mínima " << cfsMinGranularity
+              << "\n";
+}
+
+// Todos los procesos llegan a la vez (ráfagas de 20-99, prioridades al azar), así el
+// árbol llega a tener processCount listos. Se mide el coste por despacho y el desfase
+// máximo de vruntime, con tamaños crecientes para ver el crecimiento O(log n)
+void ProcessManager::runCfsBenchmark(int processCount) {
+    std::vector<int> sizes;
+    for (int size = 1000; size < processCount; size *= 10) sizes.push_back(size);
+    sizes.push_back(processCount);
+
+    SimulationConfig config;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        config = simulationConfig();
+    }
+    config.scheduler = SchedulerType::CFS;
+    config.pacingMs = 0;
+    std::cout << "\n=== Benchmark CFS (latencia " << config.cfsTargetLatency << ", granularidad "
+              << config.cfsMinGranularity << ") ===\n";
+    for (int size : sizes) {
+        std::mt19937 rng(42);
+        std::vector<Process> batch;
+        batch.reserve(size);
+        for (int i = 0; i < size; ++i) {
+            int burst = 20 + static_cast<int>(rng() % 80);
+            int priority = static_cast<int>(rng() % 4);
+            batch.push_back(Process{i + 1, burst, 0, priority, 0, ProcessState::Nuevo, burst, 0, 0, priority, -1, 0, 0, 0});
+        }
+        SimulationSummary summary = simulate(config, batch, false);
+        double ns = summary.dispatches > 0 ? summary.wallSeconds * 1e9 / summary.dispatches : 0.0;
+        std::cout << "Listos " << size << ": " << summary.dispatches << " despachos | " << ns
+                  << " ns/despacho | desfase de vruntime máx " << summary.fairnessLag << " | tiempo real "
+                  << summary.wallSeconds << " s\n";
+    }
+}
+
+long long ProcessManager::getVirtualTime() const {
+    return virtualTime;
+}
+
+// RSS actual en KB; -1 si el sistema no lo expone
+static long residentKb() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    long pages, resident;
+    if (statm >> pages >> resident) return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+    return -1;
+}
+
+// Mantiene "live" procesos vivos y en cada ciclo termina uno al azar, crea otro con
+// un pid nuevo y busca un pid vivo. Con el índice y el pool, el coste por ciclo y
+// la memoria no crecen con el total de procesos creados. No asigna memoria simulada
+void ProcessManager::runChurnBenchmark(long long cycles, int live) {
+    live = std::max(1, live);
+    const int phases = 10;
+    long long perPhase = std::max(1LL, cycles / phases);
+    ProcessManager bench(memoryManager);
+    std::mt19937 rng(42);
+    std::vector<int> alive;
+    alive.reserve(live);
+    int nextPid = 1;
+    for (int i = 0; i < live; ++i) {
+        bench.allocSlot(Process{nextPid, 1, 0, 0, 0, ProcessState::Nuevo, 1, 0, 0, 0, -1, 0, 0, 0});
+        alive.push_back(nextPid++);
+    }
+
+    std::cout << "\n=== Benchmark de creación/terminación (" << perPhase * phases << " ciclos, " << live
+              << " procesos vivos) ===\n";
+    long long checksum = 0;
+    for (int phase = 0; phase < phases; ++phase) {
+        auto start = std::chrono::steady_clock::now();
+        for (long long i = 0; i < perPhase; ++i) {
+            size_t victim = rng() % alive.size();
+            bench.freeSlot(bench.findIndexByPid(alive[victim]));
+            int burst = 1 + static_cast<int>(rng() % 20);
+            bench.allocSlot(Process{nextPid, burst, 0, 0, 0, ProcessState::Nuevo, burst, 0, 0, 0, -1, 0, 0, 0});
+            alive[victim] = nextPid++;
+            checksum += bench.findIndexByPid(alive[rng() % alive.size()]);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        long kb = residentKb();
+        std::cout << "Fase " << phase + 1 << ": " << seconds * 1e9 / perPhase << " ns/ciclo | procesos creados "
+                  << nextPid - 1 << " | ranuras " << bench.processes.size() << " | RSS ";
+        if (kb >= 0) std::cout << kb << " KB\n";
+        else std::cout << "n/d\n";
+    }
+    if (checksum < 0) std::cout << "❌ Índice de pids inconsistente\n";
+}
+
+// Cola con "queued" procesos listos: cada operación suspende uno al azar y lo
+// reanuda, así vuelve al final de la cola. Se compara con vaciar y rehacer una
+// std::queue por cada borrado, como antes, en menos operaciones porque cada una es O(n)
+void ProcessManager::runSuspendResumeBenchmark(int queued, long long operations) {
+    queued = std::max(1, queued);
+    operations = std::max(1LL, operations);
+    ProcessManager bench(memoryManager);
+    for (int pid = 1; pid <= queued; ++pid) {
+        bench.allocSlot(Process{pid, 10, 0, 0, 0, ProcessState::Listo, 10, 0, 0, 0, -1, 0, 0, 0});
+        bench.pushReady(pid);
+    }
+
+    std::cout << "\n=== Benchmark de suspender/reanudar (" << queued << " procesos en cola) ===\n";
+    std::mt19937 rng(42);
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < operations; ++i) {
+        int pid = 1 + static_cast<int>(rng() % queued);
+        std::lock_guard<std::mutex> lock(bench.mtx);
+        int idx = bench.findIndexByPid(pid);
+        bench.processes[idx].state = ProcessState::Suspendido;
+        bench.removeReady(idx);
+        bench.processes[idx].state = ProcessState::Listo;
+        bench.pushReady(pid);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double listNs = seconds * 1e9 / operations;
+    std::cout << "Lista indexada: " << operations << " operaciones | " << listNs << " ns/operación | "
+              << (seconds > 0 ? operations / seconds / 1e6 : 0.0) << " M operaciones/s\n";
+
+    long long legacyOps = std::max(1LL, std::min(operations, 50000000LL / queued));
+    std::queue<int> legacy;
+    for (int pid = 1; pid <= queued; ++pid) legacy.push(pid);
+    start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < legacyOps; ++i) {
+        int pid = 1 + static_cast<int>(rng() % queued);
+        std::queue<int> newQueue;
+        while (!legacy.empty()) {
+            if (legacy.front() != pid) newQueue.push(legacy.front());
+            legacy.pop();
+        }
+        legacy = newQueue;
+        legacy.push(pid);
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double legacyNs = seconds * 1e9 / legacyOps;
+    std::cout << "Cola reconstruida: " << legacyOps << " operaciones | " << legacyNs << " ns/operación\n";
+    if (listNs > 0) std::cout << "⚡ Aceleración: x" << legacyNs / listNs << "\n";
+    if (bench.readyList.size() != static_cast<size_t>(queued) || legacy.size() != static_cast<size_t>(queued)) {
+        std::cout << "❌ La cola de listos perdió procesos\n";
+    }
+}
+
+SchedulerStats ProcessManager::getSchedulerStats() const {
+    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mtx));
+    return schedulerStats;
+}
+
+void ProcessManager::printSchedulerStats() const {
+    SchedulerStats stats = getSchedulerStats();
+    std::cout << "\n--- Planificador ---\n";
+    std::cout << "Hilo planificador: " << (schedulerRunning ? "activo" : "detenido") << " | Ejecución automática: "
+              << (autoExecute ? "sí" : "no") << "\n";
+    std::cout << "Despachos: " << stats.dispatches << " | Despertares: " << stats.wakeups << "\n";
+    if (stats.wakeups > 0) {
+        std::cout << "Latencia de despacho: media " << stats.totalLatencyUs / stats.wakeups << " µs | máx "
+                  << stats.maxLatencyUs << " µs\n";
+    }
+    if (stats.dispatches > 0) {
+        std::cout << "Cerrojo tomado por despacho: media " << stats.totalHoldUs / stats.dispatches << " µs | máx "
+                  << stats.maxHoldUs << " µs\n";
+    }
+}
+
+// ---------------- SMP ----------------
+
+// Cada CPU tiene su reloj virtual, su cola de ejecución y una cola privada para los
+// procesos con afinidad, que nadie más puede robar. Los procesos se reparten por
+// orden de llegada turnándose entre CPUs y entran en la cola de su CPU cuando el
+// reloj de este alcanza su llegada. Un único bucle avanza siempre el CPU con el
+// reloj más bajo (a igualdad, el de menor número): ningún CPU se adelanta a los
+// demás y el resultado no depende del orden de los hilos del sistema. Ese CPU
+// despacha de su cola, alternando con la privada, y si está vacía roba el primero
+// de la cola más larga cuyo proceso ya está listo en su reloj. Si no hay nada
+// listo, queda ocioso hasta el siguiente instante en que algo puede cambiar: una
+// llegada, un proceso que vuelve a estar listo o el reloj de otro CPU
+SmpSummary ProcessManager::simulateSmp(std::vector<Process>& batch, int cpus, int quantum, int moveCost) {
+    auto wallStart = std::chrono::steady_clock::now();
+    int count = static_cast<int>(batch.size());
+    std::vector<RunQueueRing> queues(cpus);
+    std::vector<RunQueueRing> pinned(cpus);
+    std::vector<std::deque<int>> arrivals(cpus);   // Aún no llegados, por orden de llegada
+
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&batch](int a, int b) { return batch[a].arrivalTime < batch[b].arrivalTime; });
+    int next = 0;
+    for (int index : order) {
+        int affinity = batch[index].affinity;
+        if (affinity >= 0 && affinity < cpus) {
+            arrivals[affinity].push_back(index);
+        } else {
+            arrivals[next].push_back(index);
+            next = (next + 1) % cpus;
+        }
+    }
+
+    std::vector<CpuStats> stats(cpus, CpuStats{0, 0, 0, 0, 0, 0});
+    std::vector<int> lastCpu(count, -1);
+    std::vector<long long> readyAt(count);   // Llegada o fin de su último turno
+    for (int i = 0; i < count; ++i) readyAt[i] = batch[i].arrivalTime;
+    std::vector<bool> pinnedTurn(cpus, false);
+    std::vector<bool> retired(cpus, false);   // Sin nada que pueda ejecutar ya
+    int unfinished = count;
+    long long makespan = 0;
+
+    // Pasa a sus colas los procesos del CPU que ya llegaron en su reloj
+    auto admit = [&](int cpu) {
+        while (!arrivals[cpu].empty() && batch[arrivals[cpu].front()].arrivalTime <= stats[cpu].clock) {
+            int index = arrivals[cpu].front();
+            arrivals[cpu].pop_front();
+            if (batch[index].affinity == cpu) pinned[cpu].push(index);
+            else queues[cpu].push(index);
+        }
+    };
+    auto readyHead = [&](const RunQueueRing& queue, long long clock) {
+        return !queue.empty() && readyAt[queue.front()] <= clock;
+    };
+
+    // Un turno en el CPU; false si no encontró nada listo
+    auto dispatchOn = [&](int cpu) {
+        CpuStats &s = stats[cpu];
+        admit(cpu);
+        int index = RunQueueRing::EMPTY;
+        bool fromPinned = false;
+        bool pinnedReady = readyHead(pinned[cpu], s.clock);
+        if (pinnedReady && (pinnedTurn[cpu] || !readyHead(queues[cpu], s.clock))) {
+            index = pinned[cpu].pop();
+            fromPinned = true;
+        } else if (readyHead(queues[cpu], s.clock)) {
+            index = queues[cpu].pop();
+        } else {
+            // La cola más larga cuyo primer proceso ya está listo en este reloj
+            int victim = -1;
+            size_t longest = 0;
+            for (int other = 0; other < cpus; ++other) {
+                if (other == cpu || !readyHead(queues[other], s.clock)) continue;
+                if (queues[other].size() > longest) {
+                    longest = queues[other].size();
+                    victim = other;
+                }
+            }
+            if (victim == -1) return false;
+            index = queues[victim].pop();
+            s.steals++;
+        }
+        pinnedTurn[cpu] = !fromPinned;
+
+        Process &p = batch[index];
+        if (lastCpu[index] != -1 && lastCpu[index] != cpu) {
+            s.migrations++;
+            s.clock += moveCost;
+        }
+        lastCpu[index] = cpu;
+        int slice = std::min(quantum, p.remainingTime);
+        s.clock += slice;
+        s.busy += slice;
+        s.dispatches++;
+        p.remainingTime -= slice;
+        p.state = ProcessState::Listo;
+        readyAt[index] = s.clock;
+        // Como en Round Robin, los que llegaron durante el turno van delante
+        admit(cpu);
+        if (p.remainingTime == 0) {
+            unfinished--;
+            makespan = std::max(makespan, s.clock);
+        } else if (fromPinned) {
+            pinned[cpu].push(index);
+        } else {
+            queues[cpu].push(index);
+        }
+        return true;
+    };
+
+    // Primer instante posterior a su reloj en que el CPU podría encontrar trabajo;
+    // -1 si ya no queda nada que pueda ejecutar
+    auto nextChance = [&](int cpu) {
+        long long clock = stats[cpu].clock;
+        long long best = -1;
+        auto consider = [&](long long when) {
+            if (when > clock && (best == -1 || when < best)) best = when;
+        };
+        if (!arrivals[cpu].empty()) consider(batch[arrivals[cpu].front()].arrivalTime);
+        if (!pinned[cpu].empty()) consider(readyAt[pinned[cpu].front()]);
+        for (int other = 0; other < cpus; ++other) {
+            if (!queues[other].empty()) consider(readyAt[queues[other].front()]);
+            if (other == cpu || retired[other]) continue;
+            if (!arrivals[other].empty()) consider(batch[arrivals[other].front()].arrivalTime);
+            consider(stats[other].clock);
+        }
+        return best;
+    };
+
+    while (unfinished > 0) {
+        long long now = -1;
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            if (!retired[cpu] && (now == -1 || stats[cpu].clock < now)) now = stats[cpu].clock;
+        }
+        if (now == -1) break;
+        bool ran = false;
+        for (int cpu = 0; cpu < cpus && !ran; ++cpu) {
+            if (!retired[cpu] && stats[cpu].clock == now) ran = dispatchOn(cpu);
+        }
+        if (ran) continue;
+        // Ninguno de los CPUs en el instante mínimo tiene nada listo: quedan ociosos
+        std::vector<long long> wake(cpus, 0);
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            if (!retired[cpu] && stats[cpu].clock == now) wake[cpu] = nextChance(cpu);
+        }
+        for (int cpu = 0; cpu < cpus; ++cpu) {
+            if (retired[cpu] || stats[cpu].clock != now) continue;
+            if (wake[cpu] == -1) {
+                retired[cpu] = true;
+            } else {
+                stats[cpu].failedSteals++;
+                stats[cpu].clock = wake[cpu];
+            }
+        }
+    }
+
+    SmpSummary summary{cpus, count, makespan, 0.0, 0.0, 0.0, stats};
+    long long busy = 0;
+    long long maxBusy = 0;
+    for (const CpuStats &s : stats) {
+        busy += s.busy;
+        maxBusy = std::max(maxBusy, s.busy);
+    }
+    if (makespan > 0) summary.utilization = static_cast<double>(busy) / (static_cast<double>(cpus) * makespan);
+    if (busy > 0) summary.imbalance = static_cast<double>(maxBusy) * cpus / busy;
+    summary.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return summary;
+}
+
+static void printSmpSummary(const SmpSummary& summary) {
+    long long steals = 0;
+    long long failed = 0;
+    long long migrations = 0;
+    for (const CpuStats &s : summary.perCpu) {
+        steals += s.steals;
+        failed += s.failedSteals;
+        migrations += s.migrations;
+    }
+    std::cout << "📊 CPUs " << summary.cpus << ": makespan " << summary.makespan << " | Uso "
+              << summary.utilization * 100 << "% | Desequilibrio x" << summary.imbalance << " | Robos "
+              << steals << " (" << failed << " fallidos) | Migraciones " << migrations << " | Tiempo real "
+              << summary.wallSeconds << " s\n";
+}
+
+// Ejecuta los procesos nuevos y listos en varios CPUs; como runSimulation, copia el
+// lote con el cerrojo tomado, simula sin él y quedan con restante 0 a la espera de
+// terminarlos formalmente
+SmpSummary ProcessManager::runSmpSimulation(int cpus) {
+    cpus = std::max(1, cpus);
+    std::vector<Process> batch;
+    int quantum;
+    int moveCost;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (Process &p : processes) {
+            if ((p.state == ProcessState::Nuevo || p.state == ProcessState::Listo) && p.remainingTime > 0) {
+                batch.push_back(p);
+                p.state = ProcessState::Ejecutando;
+            }
+        }
+        if (batch.empty()) {
+            std::cout << "No hay procesos nuevos o listos para simular.\n";
+            return SmpSummary{cpus, 0, 0, 0.0, 0.0, 0.0, {}};
+        }
+        clearReady();
+        quantum = timeQuantum;
+        moveCost = migrationCost;
+    }
+
+    std::cout << "\n=== Simulación SMP (" << cpus << " CPUs, Round Robin, quantum " << quantum << ") ===\n";
+    SmpSummary summary = simulateSmp(batch, cpus, quantum, moveCost);
+
+    // Mientras tanto pudieron suspenderlos o terminarlos
+    std::lock_guard<std::mutex> lock(mtx);
+    for (const Process &done : batch) {
+        int idx = findIndexByPid(done.pid);
+        if (idx == -1) continue;
+        Process &p = processes[idx];
+        if (p.state != ProcessState::Ejecutando && p.state != ProcessState::Suspendido) continue;
+        p.remainingTime = done.remainingTime;
+        if (p.state == ProcessState::Ejecutando) p.state = done.state;
+    }
+    for (int cpu = 0; cpu < cpus; ++cpu) {
+        const CpuStats &s = summary.perCpu[cpu];
+        std::cout << "   CPU " << cpu << ": reloj " << s.clock << " | ocupado " << s.busy << " | despachos "
+                  << s.dispatches << " | robos " << s.steals << " | migraciones " << s.migrations << "\n";
+    }
+    printSmpSummary(summary);
+    std::cout << "💡 Use la opción 7 para terminar formalmente los procesos.\n";
+    return summary;
+}
+
+// Lote sintético con llegadas cada 0-2 unidades y ráfagas de 1-20: satura hasta
+// unos 10 CPUs, así el makespan muestra la escalabilidad y el robo reparte la carga
+void ProcessManager::runSmpBenchmark(int processCount) {
+    std::mt19937 rng(42);
+    std::vector<Process> batch;
+    batch.reserve(processCount);
+    int arrival = 0;
+    for (int i = 0; i < processCount; ++i) {
+        arrival += static_cast<int>(rng() % 3);
+        int burst = 1 + static_cast<int>(rng() % 20);
+        batch.push_back(Process{i + 1, burst, arrival, 0, 0, ProcessState::Nuevo, burst, 0, 0, 0, -1, 0, 0, 0});
+    }
+
+    int quantum;
+    int moveCost;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        quantum = timeQuantum;
+        moveCost = migrationCost;
+    }
+    std::cout << "\n=== Benchmark SMP (" << processCount << " procesos, quantum " << quantum
+              << ", migración " << moveCost << " u) ===\n";
+    long long baseline = 0;
+    for (int cpus = 1; cpus <= 16; cpus *= 2) {
+        std::vector<Process> copy = batch;
+        SmpSummary summary = simulateSmp(copy, cpus, quantum, moveCost);
+        if (cpus == 1) baseline = summary.makespan;
+        printSmpSummary(summary);
+        std::cout << "   aceleración virtual x"
+                  << (summary.makespan > 0 ? static_cast<double>(baseline) / summary.makespan : 0.0) << "\n";
+    }
+}
+
+bool ProcessManager::setAffinity(int pid, int cpu) {
+    std::lock_guard<std::mutex> lock(mtx);
+    int idx = findIndexByPid(pid);
+    if (idx == -1) {
+        std::cout << "Proceso no encontrado.\n";
+        return false;
+    }
+    processes[idx].affinity = std::max(-1, cpu);
+    if (processes[idx].affinity == -1) std::cout << "📌 Proceso " << pid << " sin afinidad: puede migrar\n";
+    else std::cout << "📌 Proceso " << pid << " fijado al CPU " << cpu << " (se ignora si hay menos CPUs)\n";
+    return true;
+}
+
+void ProcessManager::setMigrationCost(int units) {
+    std::lock_guard<std::mutex> lock(mtx);
+    migrationCost = std::max(0, units);
+    std::cout << "🔀 Coste de migración entre CPUs: " << migrationCost << " unidades\n";
+}
+
+// ---------------- Instantánea ----------------
+
+// La tabla de procesos se escribe de una vez: las ranuras libres (pid -1) van
+// incluidas para que la cola de listos pueda guardarse por ranura
+void ProcessManager::saveState(SnapshotWriter& out) {
+    static_assert(std::is_trivially_copyable<Process>::value, "Process se copia en bloque");
+    std::lock_guard<std::mutex> lock(mtx);
+    out.put<uint32_t>(sizeof(Process));
+    out.putVector(processes);
+    out.putVector(freeSlots);
+    std::vector<int> ready;
+    for (int idx = readyList.front(); idx != ReadyList::NONE; idx = readyList.next(idx)) ready.push_back(idx);
+    out.putVector(ready);
+    std::vector<int> waiting;
+    for (const auto &entry : pendingIO) waiting.push_back(entry.first);
+    out.putVector(waiting);
+
+    out.put(schedulerType);
+    out.put(timeQuantum);
+    out.put(adaptivePercentile);
+    out.put(contextSwitchCost);
+    out.putRaw(mlfqQuanta, MLFQ_LEVELS);
+    out.put(boostInterval);
+    out.put(lastBoost);
+    out.put(cfsTargetLatency);
+    out.put(cfsMinGranularity);
+    out.put(cfsMinVruntime);
+    out.put(rtPolicy);
+    out.put(rtAdmission);
+    out.put(autoExecute);
+    out.put(virtualTime);
+    out.put(pacingMs);
+    out.put(migrationCost);
+    out.put(pageInDelay);
+    out.put(localityPercent);
+    out.put(readySeq);
+    out.put(ioSeq);
+}
+
+bool ProcessManager::loadState(SnapshotReader& in, std::function<void()>& commit) {
+    uint32_t recordSize;
+    std::vector<Process> loaded;
+    std::vector<int> slots, ready, waiting;
+    if (!in.get(recordSize) || recordSize != sizeof(Process) || !in.getVector(loaded) || !in.getVector(slots) ||
+        !in.getVector(ready) || !in.getVector(waiting)) {
+        return in.fail();
+    }
+    SchedulerType type;
+    RealTimePolicy policy;
+    int quantum, percentile, switchCost, boost, targetLatency, minGranularity, pacing, migration, delay, locality, sequence;
+    int quanta[MLFQ_LEVELS];
+    long long boosted, minVruntime, clock, order;
+    bool admission, automatic;
+    if (!in.get(type) || !in.get(quantum) || !in.get(percentile) || !in.get(switchCost) ||
+        !in.getRaw(quanta, MLFQ_LEVELS) || !in.get(boost) ||
+        !in.get(boosted) || !in.get(targetLatency) || !in.get(minGranularity) || !in.get(minVruntime) ||
+        !in.get(policy) || !in.get(admission) || !in.get(automatic) || !in.get(clock) || !in.get(pacing) ||
+        !in.get(migration) || !in.get(delay) || !in.get(locality) || !in.get(order) || !in.get(sequence)) {
+        return false;
+    }
+    if (static_cast<int>(type) < 0 || static_cast<int>(type) > 4 || static_cast<int>(policy) < 0 ||
+        static_cast<int>(policy) > 1 || percentile < 0 || percentile > 100 || switchCost < 0) {
+        return in.fail();
+    }
+
+    // Pids únicos, prioridad válida (indexa los pesos de CFS) y colas que apuntan a ranuras vivas
+    std::unordered_map<int, int> index;
+    for (size_t idx = 0; idx < loaded.size(); ++idx) {
+        const Process &p = loaded[idx];
+        if (p.pid == -1) continue;
+        if (p.priority < 0 || p.priority > 3 || p.level < 0 || p.level >= MLFQ_LEVELS || static_cast<int>(p.state) < 0 ||
+            static_cast<int>(p.state) > static_cast<int>(ProcessState::Terminado) ||
+            !index.emplace(p.pid, static_cast<int>(idx)).second) {
+            return in.fail();
+        }
+    }
+    auto live = [&loaded](int idx) { return idx >= 0 && static_cast<size_t>(idx) < loaded.size() && loaded[idx].pid != -1; };
+    for (int idx : slots) {
+        if (idx < 0 || static_cast<size_t>(idx) >= loaded.size() || loaded[idx].pid != -1) return in.fail();
+    }
+    for (int idx : ready) {
+        if (!live(idx) || loaded[idx].state != ProcessState::Listo) return in.fail();
+    }
+    for (int pid : waiting) {
+        if (index.find(pid) == index.end()) return in.fail();
+    }
+
+    commit = makeSnapshotCommit([=, loaded = std::move(loaded), slots = std::move(slots), ready = std::move(ready),
+                                 waiting = std::move(waiting), index = std::move(index)]() mutable {
+        std::lock_guard<std::mutex> lock(mtx);
+        processes = std::move(loaded);
+        freeSlots = std::move(slots);
+        pidIndex = std::move(index);
+        schedulerType = type;
+        timeQuantum = quantum;
+        adaptivePercentile = percentile;
+        contextSwitchCost = switchCost;
+        rrTuner.reset(quantum, percentile);
+        std::copy(quanta, quanta + MLFQ_LEVELS, mlfqQuanta);
+        boostInterval = boost;
+        lastBoost = boosted;
+        cfsTargetLatency = targetLatency;
+        cfsMinGranularity = minGranularity;
+        cfsMinVruntime = minVruntime;
+        rtPolicy = policy;
+        rtAdmission = admission;
+        autoExecute = automatic;
+        virtualTime = clock;
+        pacingMs = pacing;
+        migrationCost = migration;
+        pageInDelay = delay;
+        localityPercent = locality;
+        readySeq = order;
+
+        clearReady();
+        readyList.reserve(processes.size());
+        for (ReadyList &level : mlfqReady) level.reserve(processes.size());
+        sjfHeap = std::priority_queue<ReadyEntry, std::vector<ReadyEntry>, std::greater<ReadyEntry>>();
+        cfsTree.clear();
+        for (int idx : ready) pushReady(processes[idx].pid);
+        // El turno en curso al guardar no llegó a contarse: el proceso vuelve a la cola
+        for (Process &p : processes) {
+            if (p.pid != -1 && p.state == ProcessState::Ejecutando) {
+                p.state = ProcessState::Listo;
+                pushReady(p.pid);
+            }
+        }
+        // Las E/S en curso no están en la instantánea: se vuelven a pedir con datos
+        // nuevos, mayores que cualquiera de los entregados antes de restaurar
+        pendingIO.clear();
+        ioSeq = std::max(ioSeq, sequence);
+        for (int pid : waiting) {
+            Process &p = processes[pidIndex[pid]];
+            if (devices != nullptr) {
+                requestDeviceIO(p);
+            } else if (p.state == ProcessState::Bloqueado) {
+                p.state = ProcessState::Listo;
+                pushReady(pid);
+            }
+        }
+        if (!readyList.empty()) notifyReady();
+        cv.notify_all();
+    });
+    return true;
 }
\ No newline at end of file
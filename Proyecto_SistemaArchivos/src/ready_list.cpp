@@ -0,0 +1,63 @@
+//ready_list.cpp
+#include "ready_list.h"
+
+ReadyList::ReadyList() : head(NONE), tail(NONE), count(0) {}
+
+void ReadyList::reserve(size_t slots) {
+    if (slots > links.size()) links.resize(slots, Link{OUTSIDE, NONE});
+}
+
+bool ReadyList::contains(int slot) const {
+    return slot >= 0 && static_cast<size_t>(slot) < links.size() && links[slot].prev != OUTSIDE;
+}
+
+bool ReadyList::pushBack(int slot) {
+    if (slot < 0) return false;
+    reserve(static_cast<size_t>(slot) + 1);
+    if (links[slot].prev != OUTSIDE) return false;
+    links[slot] = Link{tail, NONE};
+    if (tail == NONE) head = slot;
+    else links[tail].next = slot;
+    tail = slot;
+    count++;
+    return true;
+}
+
+int ReadyList::popFront() {
+    int slot = head;
+    if (slot != NONE) remove(slot);
+    return slot;
+}
+
+bool ReadyList::remove(int slot) {
+    if (!contains(slot)) return false;
+    Link link = links[slot];
+    if (link.prev == NONE) head = link.next;
+    else links[link.prev].next = link.next;
+    if (link.next == NONE) tail = link.prev;
+    else links[link.next].prev = link.prev;
+    links[slot] = Link{OUTSIDE, NONE};
+    count--;
+    return true;
+}
+
+int ReadyList::front() const {
+    return head;
+}
+
+int ReadyList::next(int slot) const {
+    return links[slot].next;
+}
+
+bool ReadyList::empty() const {
+    return count == 0;
+}
+
+size_t ReadyList::size() const {
+    return count;
+}
+
+// Solo recorre las ranuras enlazadas
+void ReadyList::clear() {
+    while (head != NONE) remove(head);
+}
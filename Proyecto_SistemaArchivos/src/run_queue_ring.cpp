@@ -0,0 +1,43 @@
+//run_queue_ring.cpp
+#include "run_queue_ring.h"
+
+RunQueueRing::RunQueueRing(size_t capacity) : head(0), count(0) {
+    size_t size = 16;
+    while (size < capacity) size <<= 1;
+    buffer.resize(size);
+}
+
+// Copia los elementos en orden al principio de un anillo del doble de tamaño
+void RunQueueRing::grow() {
+    std::vector<int> larger(buffer.size() * 2);
+    size_t mask = buffer.size() - 1;
+    for (size_t i = 0; i < count; ++i) larger[i] = buffer[(head + i) & mask];
+    buffer.swap(larger);
+    head = 0;
+}
+
+void RunQueueRing::push(int value) {
+    if (count == buffer.size()) grow();
+    buffer[(head + count) & (buffer.size() - 1)] = value;
+    count++;
+}
+
+int RunQueueRing::pop() {
+    if (count == 0) return EMPTY;
+    int value = buffer[head];
+    head = (head + 1) & (buffer.size() - 1);
+    count--;
+    return value;
+}
+
+int RunQueueRing::front() const {
+    return count == 0 ? EMPTY : buffer[head];
+}
+
+size_t RunQueueRing::size() const {
+    return count;
+}
+
+bool RunQueueRing::empty() const {
+    return count == 0;
+}
@@ -0,0 +1,220 @@
+//snapshot.cpp
+#include "snapshot.h"
+#include "file_system.h"
+#include "process_manager.h"
+#include "memory_manager.h"
+#include "disk_scheduler.h"
+#include "device_manager.h"
+#include <fstream>
+#include <chrono>
+#include <cstring>
+
+// Cabecera: "SOSNAP", marca de orden de bytes y versión
+static const char SNAPSHOT_MAGIC[6] = {'S', 'O', 'S', 'N', 'A', 'P'};
+static const uint16_t ENDIAN_MARK = 0x0102;
+static const uint64_t NO_SECTION = ~0ULL;
+static const size_t STREAM_BUFFER = 1 << 20;
+
+static constexpr uint32_t sectionTag(const char (&name)[5]) {
+    return static_cast<uint32_t>(name[0]) | static_cast<uint32_t>(name[1]) << 8 |
+           static_cast<uint32_t>(name[2]) << 16 | static_cast<uint32_t>(name[3]) << 24;
+}
+
+// Orden de las secciones en el archivo y al restaurar: la memoria va antes que los
+// dispositivos (al restaurarla se esperan las transferencias de swap pendientes) y
+// los procesos al final (vuelven a pedir la E/S que tenían en curso)
+static const uint32_t SECTION_ORDER[] = {sectionTag("FSYS"), sectionTag("DISK"), sectionTag("MEMO"),
+                                         sectionTag("DEVS"), sectionTag("PROC"), sectionTag("END_")};
+static const int SECTION_COUNT = sizeof(SECTION_ORDER) / sizeof(SECTION_ORDER[0]);
+
+// ---------------- SnapshotWriter ----------------
+
+SnapshotWriter::SnapshotWriter(std::ostream& stream) : out(stream), sectionStart(-1) {}
+
+void SnapshotWriter::putString(const std::string& text) {
+    put<uint64_t>(text.size());
+    putRaw(text.data(), text.size());
+}
+
+void SnapshotWriter::beginSection(uint32_t tag) {
+    put(tag);
+    sectionStart = out.tellp();
+    put<uint64_t>(0);
+}
+
+void SnapshotWriter::endSection() {
+    std::streampos end = out.tellp();
+    uint64_t length = static_cast<uint64_t>(end - sectionStart) - sizeof(uint64_t);
+    out.seekp(sectionStart);
+    put(length);
+    out.seekp(end);
+}
+
+bool SnapshotWriter::good() const {
+    return out.good();
+}
+
+// ---------------- SnapshotReader ----------------
+
+SnapshotReader::SnapshotReader(std::istream& stream) : in(stream), remaining(NO_SECTION), ok(true) {}
+
+bool SnapshotReader::take(uint64_t bytes) {
+    if (!ok || bytes > remaining) return fail();
+    if (remaining != NO_SECTION) remaining -= bytes;
+    return true;
+}
+
+bool SnapshotReader::getCount(uint64_t& count, size_t minBytesEach) {
+    if (!get(count)) return false;
+    if (minBytesEach > 0 && count > remaining / minBytesEach) return fail();
+    return true;
+}
+
+bool SnapshotReader::getString(std::string& text) {
+    uint64_t length;
+    if (!getCount(length, 1)) return false;
+    text.resize(length);
+    return getRaw(&text[0], length);
+}
+
+bool SnapshotReader::beginSection(uint32_t tag) {
+    uint32_t found;
+    uint64_t length;
+    remaining = NO_SECTION;
+    if (!get(found) || !get(length) || found != tag) return fail();
+    remaining = length;
+    return true;
+}
+
+bool SnapshotReader::endSection() {
+    if (!ok || remaining != 0) return fail();
+    remaining = NO_SECTION;
+    return true;
+}
+
+bool SnapshotReader::fail() {
+    ok = false;
+    return false;
+}
+
+bool SnapshotReader::good() const {
+    return ok;
+}
+
+// ---------------- Snapshot ----------------
+
+bool Snapshot::save(const std::string& path, FileSystem& fs, ProcessManager& pm, MemoryManager& mm,
+                    DiskScheduler& disk, DeviceManager& devices) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<char> buffer(STREAM_BUFFER);
+    std::ofstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cout << "❌ No se pudo crear la instantánea '" << path << "'\n";
+        return false;
+    }
+
+    SnapshotWriter out(file);
+    out.putRaw(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    out.put(ENDIAN_MARK);
+    out.put(VERSION);
+    for (uint32_t tag : SECTION_ORDER) {
+        out.beginSection(tag);
+        if (tag == sectionTag("FSYS")) fs.saveState(out);
+        else if (tag == sectionTag("DISK")) disk.saveState(out);
+        else if (tag == sectionTag("MEMO")) mm.saveState(out);
+        else if (tag == sectionTag("DEVS")) devices.saveState(out);
+        else if (tag == sectionTag("PROC")) pm.saveState(out);
+        out.endSection();
+    }
+    std::streamoff bytes = file.tellp();
+    file.close();
+    if (!out.good() || file.fail()) {
+        std::cout << "❌ Error al escribir la instantánea '" << path << "'\n";
+        return false;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "💾 Instantánea guardada en '" << path << "' (" << bytes << " bytes, " << ms << " ms)\n";
+    return true;
+}
+
+bool Snapshot::load(const std::string& path, FileSystem& fs, ProcessManager& pm, MemoryManager& mm,
+                    DiskScheduler& disk, DeviceManager& devices) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<char> buffer(STREAM_BUFFER);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    file.open(path, std::ios::binary);
+    if (!file) {
+        std::cout << "❌ No se pudo abrir la instantánea '" << path << "'\n";
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    SnapshotReader in(file);
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    uint16_t endian = 0;
+    uint32_t version = 0;
+    if (!in.getRaw(magic, sizeof(magic)) || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0) {
+        std::cout << "❌ '" << path << "' no es una instantánea\n";
+        return false;
+    }
+    if (!in.get(endian) || !in.get(version) || endian != ENDIAN_MARK) {
+        std::cout << "❌ Instantánea escrita en otra arquitectura (orden de bytes distinto)\n";
+        return false;
+    }
+    if (version != VERSION) {
+        std::cout << "❌ Instantánea de la versión " << version << " (se esperaba " << VERSION << ")\n";
+        return false;
+    }
+
+    // Antes de tocar ningún gestor se recorren las secciones: un archivo truncado
+    // o con longitudes corruptas se rechaza sin leer su contenido
+    std::streampos body = file.tellg();
+    uint64_t position = static_cast<uint64_t>(body);
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        uint32_t tag;
+        uint64_t length;
+        file.read(reinterpret_cast<char*>(&tag), sizeof(tag));
+        file.read(reinterpret_cast<char*>(&length), sizeof(length));
+        position += sizeof(tag) + sizeof(length);
+        if (!file || tag != SECTION_ORDER[i] || length > fileSize - position) {
+            std::cout << "❌ Instantánea dañada o truncada (sección " << i + 1 << ")\n";
+            return false;
+        }
+        position += length;
+        file.seekg(static_cast<std::streamoff>(position));
+    }
+    if (position != fileSize) {
+        std::cout << "❌ Instantánea dañada: datos después de la última sección\n";
+        return false;
+    }
+    file.seekg(body);
+
+    // Todas las secciones se leen y validan antes de aplicar ninguna: si una falla,
+    // ningún gestor cambia
+    std::vector<std::function<void()>> commits(SECTION_COUNT - 1);
+    for (int i = 0; i < SECTION_COUNT - 1; ++i) {
+        uint32_t tag = SECTION_ORDER[i];
+        bool loaded = in.beginSection(tag);
+        if (loaded) {
+            if (tag == sectionTag("FSYS")) loaded = fs.loadState(in, commits[i]);
+            else if (tag == sectionTag("DISK")) loaded = disk.loadState(in, commits[i]);
+            else if (tag == sectionTag("MEMO")) loaded = mm.loadState(in, commits[i]);
+            else if (tag == sectionTag("DEVS")) loaded = devices.loadState(in, commits[i]);
+            else if (tag == sectionTag("PROC")) loaded = pm.loadState(in, commits[i]);
+        }
+        if (!loaded || !in.endSection()) {
+            std::cout << "❌ Contenido inválido en la sección " << i + 1
+                      << " de la instantánea (no se restauró nada)\n";
+            return false;
+        }
+    }
+    for (const auto &commit : commits) commit();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "📂 Instantánea restaurada desde '" << path << "' (" << fileSize << " bytes, " << ms << " ms)\n";
+    return true;
+}
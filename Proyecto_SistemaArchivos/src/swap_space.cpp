@@ -0,0 +1,85 @@
+//swap_space.cpp
+#include "swap_space.h"
+#include <cstring>
+#include <cstdio>
+
+SwapSpace::SwapSpace(const std::string& path) : path(path), nextSlot(0) {
+    // trunc: el contenido de una ejecución anterior no es válido
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+}
+
+SwapSpace::~SwapSpace() {
+    if (file.is_open()) {
+        file.close();
+        std::remove(path.c_str());
+    }
+}
+
+bool SwapSpace::isOpen() const {
+    return file.is_open();
+}
+
+const std::string& SwapSpace::getPath() const {
+    return path;
+}
+
+int SwapSpace::slotFor(uint64_t key) const {
+    auto it = slots.find(key);
+    return it != slots.end() ? it->second : -1;
+}
+
+int SwapSpace::assignSlot(uint64_t key) {
+    auto it = slots.find(key);
+    if (it != slots.end()) return it->second;
+
+    int slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = nextSlot++;
+    }
+    slots.emplace(key, slot);
+    return slot;
+}
+
+void SwapSpace::releaseProcess(int processId) {
+    for (auto it = slots.begin(); it != slots.end();) {
+        if (static_cast<int>(it->first >> 32) == processId) {
+            freeSlots.push_back(it->second);
+            it = slots.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int SwapSpace::usedSlots() const {
+    return static_cast<int>(slots.size());
+}
+
+// Cada ranura lleva una cabecera (proceso, página) para validar la lectura
+bool SwapSpace::writeSlot(int slot, int processId, int virtualPage) {
+    char buffer[PAGE_SIZE];
+    int header[2] = {processId, virtualPage};
+    std::memset(buffer, virtualPage & 0xff, sizeof(buffer));
+    std::memcpy(buffer, header, sizeof(header));
+
+    file.seekp(static_cast<std::streamoff>(slot) * PAGE_SIZE);
+    file.write(buffer, sizeof(buffer));
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+bool SwapSpace::readSlot(int slot, int processId, int virtualPage) {
+    char buffer[PAGE_SIZE];
+    file.seekg(static_cast<std::streamoff>(slot) * PAGE_SIZE);
+    file.read(buffer, sizeof(buffer));
+    if (!file) {
+        file.clear();
+        return false;
+    }
+    int header[2];
+    std::memcpy(header, buffer, sizeof(header));
+    return header[0] == processId && header[1] == virtualPage;
+}
@@ -0,0 +1,248 @@
+//sweep_runner.cpp
+#include "sweep_runner.h"
+#include "workload_generator.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+
+static const char* policyName(PageReplacement policy) {
+    switch (policy) {
+        case PageReplacement::FIFO: return "FIFO";
+        case PageReplacement::LRU: return "LRU";
+        case PageReplacement::WORKING_SET: return "WS";
+        case PageReplacement::OPT: return "OPT";
+    }
+    return "?";
+}
+
+static const char* schedulerLabel(SchedulerType type) {
+    switch (type) {
+        case SchedulerType::RR: return "RR";
+        case SchedulerType::SJF: return "SJF";
+        case SchedulerType::MLFQ: return "MLFQ";
+        case SchedulerType::SRTF: return "SRTF";
+        case SchedulerType::CFS: return "CFS";
+    }
+    return "?";
+}
+
+// Lista de enteros positivos separados por comas o espacios; "a-b" es un rango
+static bool parseList(const std::string& text, std::vector<long long>& values) {
+    std::string normalized = text;
+    for (char &c : normalized) {
+        if (c == ',') c = ' ';
+    }
+    std::istringstream in(normalized);
+    std::string token;
+    values.clear();
+    while (in >> token) {
+        char *end;
+        long long first = std::strtoll(token.c_str(), &end, 10);
+        long long last = first;
+        if (*end == '-') last = std::strtoll(end + 1, &end, 10);
+        if (*end != '\0' || first < 0 || last < first || last - first > 100000) return false;
+        for (long long value = first; value <= last; ++value) values.push_back(value);
+    }
+    return !values.empty();
+}
+
+bool SweepRunner::loadSpec(const std::string& path, SweepSpec& spec) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cout << "❌ No se pudo abrir el barrido " << path << "\n";
+        return false;
+    }
+    spec = SweepSpec();
+    std::string line;
+    int lineNumber = 0;
+    std::vector<long long> values;
+    auto value = [&line](size_t prefix) { return line.substr(prefix); };
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        bool ok = true;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        } else if (line.rfind("PLANIFICADOR:", 0) == 0) {
+            if (line.find("Round Robin") != std::string::npos) spec.scheduler = SchedulerType::RR;
+            else if (line.find("SRTF") != std::string::npos) spec.scheduler = SchedulerType::SRTF;
+            else if (line.find("SJF") != std::string::npos) spec.scheduler = SchedulerType::SJF;
+            else if (line.find("MLFQ") != std::string::npos) spec.scheduler = SchedulerType::MLFQ;
+            else if (line.find("CFS") != std::string::npos) spec.scheduler = SchedulerType::CFS;
+            else ok = false;
+        } else if (line.rfind("POLÍTICA:", 0) == 0) {
+            spec.policies.clear();
+            std::istringstream names(value(std::string("POLÍTICA:").size()));
+            std::string name;
+            while (ok && std::getline(names, name, ',')) {
+                if (name.find("FIFO") != std::string::npos) spec.policies.push_back(PageReplacement::FIFO);
+                else if (name.find("LRU") != std::string::npos) spec.policies.push_back(PageReplacement::LRU);
+                else if (name.find("Working Set") != std::string::npos || name.find("WS") != std::string::npos) {
+                    spec.policies.push_back(PageReplacement::WORKING_SET);
+                } else {
+                    ok = false;   // OPT necesita las referencias futuras: no se reproduce unidad a unidad
+                }
+            }
+            ok = ok && !spec.policies.empty();
+        } else if (line.rfind("Quantum:", 0) == 0) {
+            ok = parseList(value(8), values);
+            spec.quanta.assign(values.begin(), values.end());
+        } else if (line.rfind("Marcos:", 0) == 0) {
+            ok = parseList(value(7), values);
+            spec.frames.assign(values.begin(), values.end());
+        } else if (line.rfind("Semillas:", 0) == 0) {
+            ok = parseList(value(9), values);
+            spec.seeds.assign(values.begin(), values.end());
+        } else if (line.rfind("Procesos:", 0) == 0) {
+            spec.processes = std::atoi(line.c_str() + 9);
+        } else if (line.rfind("Llegada media:", 0) == 0) {
+            spec.meanGap = std::atof(line.c_str() + 14);
+        } else if (line.rfind("Ráfaga media:", 0) == 0) {
+            spec.meanBurst = std::atof(line.c_str() + std::string("Ráfaga media:").size());
+        } else if (line.rfind("Alfa:", 0) == 0) {
+            spec.alpha = std::atof(line.c_str() + 5);
+        } else if (line.rfind("Páginas:", 0) == 0) {
+            spec.pageSpan = std::atoi(line.c_str() + std::string("Páginas:").size());
+        } else if (line.rfind("Conjunto de trabajo:", 0) == 0) {
+            spec.workingSet = std::atoi(line.c_str() + 20);
+        } else if (line.rfind("Lectura de página:", 0) == 0) {
+            spec.pageInDelay = std::atoi(line.c_str() + std::string("Lectura de página:").size());
+        } else if (line.rfind("Localidad:", 0) == 0) {
+            spec.locality = std::atoi(line.c_str() + 10);
+        } else if (line.rfind("Ventana de trabajo:", 0) == 0) {
+            spec.window = std::atoi(line.c_str() + 19);
+        } else if (line.rfind("Cambio de contexto:", 0) == 0) {
+            spec.switchCost = std::atoi(line.c_str() + 19);
+        } else if (line.rfind("Hilos:", 0) == 0) {
+            spec.threads = std::atoi(line.c_str() + 6);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cout << "❌ Línea " << lineNumber << " del barrido no válida: " << line << "\n";
+            return false;
+        }
+    }
+
+    // Lo que no se indica queda con un único valor
+    if (spec.quanta.empty()) spec.quanta.push_back(2);
+    if (spec.policies.empty()) spec.policies.push_back(PageReplacement::FIFO);
+    if (spec.frames.empty()) spec.frames.push_back(64);
+    if (spec.seeds.empty()) spec.seeds.push_back(42);
+    for (int quantum : spec.quanta) {
+        if (quantum < 1) {
+            std::cout << "❌ Los quanta deben ser positivos\n";
+            return false;
+        }
+    }
+    for (int frames : spec.frames) {
+        if (frames < 1) {
+            std::cout << "❌ Los marcos deben ser positivos\n";
+            return false;
+        }
+    }
+    if (spec.processes < 1 || spec.switchCost < 0 || spec.meanGap < 0 || spec.meanBurst < 1 || spec.alpha <= 0 || spec.pageSpan < 0 ||
+        (spec.pageSpan > 0 && (spec.workingSet < 1 || spec.workingSet > spec.pageSpan))) {
+        std::cout << "❌ Carga no válida: procesos >= 1, cambio de contexto >= 0, ráfaga media >= 1, alfa > 0 y conjunto de trabajo "
+                  << "entre 1 y el número de páginas\n";
+        return false;
+    }
+    return true;
+}
+
+// Gestores propios y sin salida por consola: los puntos no comparten estado
+SweepPoint SweepRunner::runPoint(const SweepSpec& spec, int quantum, PageReplacement policy, int frames,
+                                 uint64_t seed) {
+    WorkloadGenerator generator(seed);
+    std::vector<Process> batch = generator.makeProcesses(spec.processes, spec.meanGap, spec.meanBurst, spec.alpha);
+    for (Process &p : batch) {
+        p.pageSpan = spec.pageSpan;
+        p.workingSet = spec.pageSpan > 0 ? spec.workingSet : 0;
+    }
+    MemoryManager memory(frames);
+    memory.setReplacementPolicy(policy, false);
+    memory.setWorkingSetWindow(spec.window, false);
+    ProcessManager pm(&memory);
+    pm.setScheduler(spec.scheduler, quantum, false);
+    pm.setPagingParams(spec.pageInDelay, spec.locality, false);
+    pm.setContextSwitchCost(spec.switchCost, false);
+    return SweepPoint{quantum, policy, frames, seed, pm.runWorkload(batch, false)};
+}
+
+bool SweepRunner::run(const SweepSpec& spec, const std::string& csvPath) {
+    struct Config {
+        int quantum;
+        PageReplacement policy;
+        int frames;
+        uint64_t seed;
+    };
+    std::vector<Config> configs;
+    for (int quantum : spec.quanta) {
+        for (PageReplacement policy : spec.policies) {
+            for (int frames : spec.frames) {
+                for (uint64_t seed : spec.seeds) configs.push_back(Config{quantum, policy, frames, seed});
+            }
+        }
+    }
+    std::ofstream out(csvPath);
+    if (!out) {
+        std::cout << "❌ No se pudo crear el archivo '" << csvPath << "'\n";
+        return false;
+    }
+
+    int threads = spec.threads > 0 ? spec.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threads = static_cast<int>(std::min<size_t>(threads, configs.size()));
+    std::cout << "\n🧪 Barrido de " << configs.size() << " configuraciones (" << schedulerLabel(spec.scheduler) << ", "
+              << spec.processes << " procesos cada una) en " << threads << " hilo(s)...\n" << std::flush;
+
+    // Cada hilo toma la siguiente configuración libre; el resultado va a su posición
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SweepPoint> results(configs.size());
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            for (size_t i = next++; i < configs.size(); i = next++) {
+                const Config &config = configs[i];
+                results[i] = runPoint(spec, config.quantum, config.policy, config.frames, config.seed);
+            }
+        });
+    }
+    for (auto &thread : pool) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Sin tiempos reales: el archivo depende solo del barrido
+    out << "planificador,quantum,politica,marcos,semilla,procesos,fin,despachos,cambios_contexto,sobrecarga,"
+        << "espera_media,respuesta_media,retorno_medio,throughput,uso_cpu,uso_disco,referencias,fallos,fallos_por_mil\n";
+    for (const SweepPoint &point : results) {
+        const SimulationSummary &s = point.summary;
+        double faultRate = s.pageReferences > 0 ? 1000.0 * s.pageFaults / s.pageReferences : 0.0;
+        out << schedulerLabel(spec.scheduler) << "," << point.quantum << "," << policyName(point.policy) << ","
+            << point.frames << "," << point.seed << "," << s.processes << "," << s.finishTime << "," << s.dispatches
+            << "," << s.contextSwitches << "," << s.switchOverhead << "," << s.avgWaiting << "," << s.avgResponse << "," << s.avgTurnaround << "," << s.throughput << ","
+            << s.utilization << "," << s.deviceUtilization << "," << s.pageReferences << "," << s.pageFaults << ","
+            << faultRate << "\n";
+    }
+    if (!out) {
+        std::cout << "❌ Error al escribir '" << csvPath << "'\n";
+        return false;
+    }
+
+    // La configuración con menor retorno medio (a igualdad, la primera del barrido)
+    size_t best = 0;
+    for (size_t i = 1; i < results.size(); ++i) {
+        if (results[i].summary.avgTurnaround < results[best].summary.avgTurnaround) best = i;
+    }
+    std::cout << "✅ " << results.size() << " configuraciones en " << seconds << " s ("
+              << results.size() / std::max(seconds, 1e-9) << " por segundo) | Resultados en '" << csvPath << "'\n";
+    if (!results.empty()) {
+        const SweepPoint &point = results[best];
+        std::cout << "🏆 Menor retorno medio: quantum " << point.quantum << ", " << policyName(point.policy) << ", "
+                  << point.frames << " marcos, semilla " << point.seed << " (" << point.summary.avgTurnaround << ")\n";
+    }
+    return true;
+}
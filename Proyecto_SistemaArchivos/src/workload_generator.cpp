@@ -0,0 +1,199 @@
+//workload_generator.cpp
+#include "workload_generator.h"
+#include <cmath>
+#include <climits>
+#include <chrono>
+
+static const int PAGE_TURN = 256;          // Referencias seguidas de un mismo proceso
+static const int MAX_BURST = 1000000;      // Tope de la cola de Pareto
+static const size_t MEMORY_CHUNK = 65536;
+
+WorkloadGenerator::WorkloadGenerator(uint64_t seed) : seed(seed), rng(seed) {
+    setPageLocality(8, 1024, 1.0, 100000, 10);
+    setDiskPattern(200, 30);
+    reseed(seed);
+}
+
+void WorkloadGenerator::reseed(uint64_t newSeed) {
+    seed = newSeed;
+    rng.seed(newSeed);
+    phaseOffset.assign(pageProcesses, 0);
+    refsInPhase = 0;
+    currentProcess = 0;
+    refsLeftInTurn = 0;
+    lastTrack = -1;
+}
+
+uint64_t WorkloadGenerator::getSeed() const {
+    return seed;
+}
+
+// 53 bits aleatorios; nunca devuelve 0, así el logaritmo y la potencia son finitos
+double WorkloadGenerator::uniform() {
+    return static_cast<double>((rng() >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+std::vector<Process> WorkloadGenerator::makeProcesses(int count, double meanGap, double meanBurst, double alpha,
+                                                      int firstPid) {
+    std::vector<Process> batch;
+    if (count <= 0) return batch;
+    batch.reserve(count);
+    if (alpha <= 0.0) alpha = 1.5;
+    // Pareto con mínimo xm: media alpha*xm/(alpha-1), infinita si alpha <= 1
+    double scale = alpha > 1.0 ? meanBurst * (alpha - 1.0) / alpha : meanBurst;
+    double clock = 0.0;
+    for (int i = 0; i < count; ++i) {
+        clock += -meanGap * std::log(uniform());
+        int arrival = clock < INT_MAX ? static_cast<int>(clock) : INT_MAX;
+        double length = std::ceil(scale / std::pow(uniform(), 1.0 / alpha));
+        int burst = length < MAX_BURST ? std::max(1, static_cast<int>(length)) : MAX_BURST;
+        int priority = static_cast<int>(rng() % 4);
+        batch.push_back(Process{firstPid + i, burst, arrival, priority, 0, ProcessState::Nuevo, burst, 0, 0, priority,
+                                -1, 0, 0, 0});
+    }
+    return batch;
+}
+
+void WorkloadGenerator::buildZipf() {
+    zipfCdf.resize(pagesPerProcess);
+    double total = 0.0;
+    for (int rank = 0; rank < pagesPerProcess; ++rank) {
+        total += 1.0 / std::pow(rank + 1.0, zipfExponent);
+        zipfCdf[rank] = total;
+    }
+    for (double &value : zipfCdf) value /= total;
+}
+
+// Rango 0 = página más popular; búsqueda binaria en la distribución acumulada
+int WorkloadGenerator::zipfRank() {
+    double u = uniform();
+    int rank = static_cast<int>(std::lower_bound(zipfCdf.begin(), zipfCdf.end(), u) - zipfCdf.begin());
+    return std::min(rank, pagesPerProcess - 1);
+}
+
+void WorkloadGenerator::setPageLocality(int processes, int pages, double zipfS, long long phase, int writes) {
+    pageProcesses = std::max(1, processes);
+    pagesPerProcess = std::max(1, pages);
+    zipfExponent = std::max(0.0, zipfS);
+    phaseLength = std::max(0LL, phase);
+    writePercent = std::min(100, std::max(0, writes));
+    buildZipf();
+    phaseOffset.assign(pageProcesses, 0);
+    refsInPhase = 0;
+    refsLeftInTurn = 0;
+}
+
+// Cada proceso usa PAGE_TURN referencias seguidas (como un quantum). Al cambiar de
+// fase, el conjunto caliente de todos los procesos salta a otra zona de sus páginas
+void WorkloadGenerator::nextPageRefs(std::vector<PageRef>& out, size_t count) {
+    out.clear();
+    out.reserve(count);
+    for (size_t n = 0; n < count; ++n) {
+        if (phaseLength > 0 && refsInPhase == phaseLength) {
+            for (int &offset : phaseOffset) offset = static_cast<int>(rng() % pagesPerProcess);
+            refsInPhase = 0;
+        }
+        if (refsLeftInTurn == 0) {
+            currentProcess = static_cast<int>(rng() % pageProcesses);
+            refsLeftInTurn = PAGE_TURN;
+        }
+        int page = (zipfRank() + phaseOffset[currentProcess]) % pagesPerProcess;
+        bool write = static_cast<int>(rng() % 100) < writePercent;
+        out.push_back(PageRef{currentProcess + 1, page, write});
+        refsLeftInTurn--;
+        refsInPhase++;
+    }
+}
+
+void WorkloadGenerator::setDiskPattern(int tracks, int sequential) {
+    diskTracks = std::max(1, tracks);
+    sequentialPercent = std::min(100, std::max(0, sequential));
+    lastTrack = -1;
+}
+
+// sequentialPercent% de las solicitudes siguen en la pista contigua a la anterior
+void WorkloadGenerator::nextDiskRequests(std::vector<DiskRequest>& out, size_t count, int processes) {
+    out.clear();
+    out.reserve(count);
+    if (processes < 1) processes = 1;
+    for (size_t n = 0; n < count; ++n) {
+        if (lastTrack < 0 || static_cast<int>(rng() % 100) >= sequentialPercent) {
+            lastTrack = static_cast<int>(rng() % diskTracks);
+        } else {
+            lastTrack = (lastTrack + 1) % diskTracks;
+        }
+        out.push_back(DiskRequest{lastTrack, 1 + static_cast<int>(rng() % processes)});
+    }
+}
+
+SimulationSummary WorkloadGenerator::feedProcesses(ProcessManager& pm, int count) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Process> batch = makeProcesses(count);
+    double generated = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\n🎲 " << count << " procesos generados en " << generated << " s (semilla " << seed << ")\n";
+    SimulationSummary summary = pm.runWorkload(batch);
+    if (summary.wallSeconds > 0) {
+        std::cout << "⚡ " << summary.events / summary.wallSeconds / 1e6 << " M eventos/s\n";
+    }
+    return summary;
+}
+
+AccessResult WorkloadGenerator::feedMemory(MemoryManager& mm, long long refs) {
+    AccessResult total{0, 0};
+    std::vector<PageRef> chunk;
+    double inManager = 0.0;
+    for (long long done = 0; done < refs; done += MEMORY_CHUNK) {
+        size_t count = static_cast<size_t>(std::min<long long>(MEMORY_CHUNK, refs - done));
+        nextPageRefs(chunk, count);
+        auto start = std::chrono::steady_clock::now();
+        AccessResult partial = mm.accessPages(chunk);
+        inManager += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        total.hits += partial.hits;
+        total.faults += partial.faults;
+    }
+    std::cout << "\n🧠 " << refs << " referencias (Zipf s=" << zipfExponent << ", fase " << phaseLength
+              << ") | Hits: " << total.hits << " | Faults: " << total.faults << " ("
+              << (refs > 0 ? 100.0 * total.faults / refs : 0.0) << "%)\n";
+    if (inManager > 0) std::cout << "⚡ " << refs / inManager / 1e6 << " M referencias/s en el gestor de memoria\n";
+    return total;
+}
+
+long long WorkloadGenerator::feedDisk(const DiskScheduler& disk, long long requests, DiskAlgorithm algorithm,
+                                      int queueDepth) {
+    if (queueDepth < 1) queueDepth = 1;
+    const char* name = algorithm == DiskAlgorithm::FCFS ? "FCFS" : algorithm == DiskAlgorithm::SSTF ? "SSTF" : "SCAN";
+    int head = disk.getHeadPosition();
+    long long movement = 0;
+    std::vector<DiskRequest> queue;
+    double inScheduler = 0.0;
+    for (long long done = 0; done < requests; done += queueDepth) {
+        size_t count = static_cast<size_t>(std::min<long long>(queueDepth, requests - done));
+        nextDiskRequests(queue, count);
+        auto start = std::chrono::steady_clock::now();
+        movement += disk.serveRequests(queue, algorithm, head);
+        inScheduler += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::cout << "💿 " << name << ": " << requests << " solicitudes en colas de " << queueDepth << " | Movimiento: "
+              << movement << " pistas (" << (requests > 0 ? static_cast<double>(movement) / requests : 0.0)
+              << " por solicitud)";
+    if (inScheduler > 0) std::cout << " | " << requests / inScheduler / 1e6 << " M solicitudes/s";
+    std::cout << "\n";
+    return movement;
+}
+
+// Cada proceso aporta al menos su llegada y su fin; el lote se limita para que quepa
+// en memoria, mientras que referencias y solicitudes se generan por tramos
+void WorkloadGenerator::runStress(ProcessManager& pm, MemoryManager& mm, const DiskScheduler& disk, long long events) {
+    if (events < 1) events = 1;
+    int processes = static_cast<int>(std::max(1LL, std::min(events / 4, 4000000LL)));
+    std::cout << "\n=== Carga sintética: " << events << " eventos por gestor (semilla " << seed << ") ===\n";
+    feedProcesses(pm, processes);
+    feedMemory(mm, events);
+    std::cout << "\n";
+    // Los tres algoritmos reciben el mismo flujo de solicitudes
+    for (DiskAlgorithm algorithm : {DiskAlgorithm::FCFS, DiskAlgorithm::SSTF, DiskAlgorithm::SCAN}) {
+        WorkloadGenerator stream(seed);
+        stream.setDiskPattern(diskTracks, sequentialPercent);
+        stream.feedDisk(disk, events, algorithm);
+    }
+}